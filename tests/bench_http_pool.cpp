@@ -0,0 +1,47 @@
+// 本地回环服务器上比较开启与关闭连接复用时 getResultAsync 的延迟
+// 用法: bench_http_pool [新连接的额外延迟 (毫秒)] [请求数]
+// 本地回环没有真实网络的 TCP 与 TLS 握手开销，可以用第一个参数模拟
+
+#include <future>
+
+#include "bilibili/util/http.hpp"
+#include "bilibili/util/session_pool.hpp"
+#include "loopback_server.hpp"
+
+using namespace bilibili;
+
+/// 依次发送 count 个请求，返回每个请求从发出到回调的耗时
+static std::vector<double> run(const std::string& url, int count) {
+    std::vector<double> samples;
+    for (int i = 0; i < count; i++) {
+        std::promise<bool> done;
+        test::Timer timer;
+        // 参数各不相同，避免请求被合并
+        HTTP::getResultAsync<nlohmann::json>(
+            url, {{"i", std::to_string(i)}},
+            [&done](const nlohmann::json&) { done.set_value(true); },
+            [&done](const std::string&) { done.set_value(false); });
+        CHECK(done.get_future().get());
+        samples.push_back(timer.elapsed());
+    }
+    return samples;
+}
+
+int main(int argc, char** argv) {
+    int handshake = argc > 1 ? std::stoi(argv[1]) : 0;
+    int count     = argc > 2 ? std::stoi(argv[2]) : 100;
+    LoopbackServer server(handshake,
+                          R"({"code":0,"message":"0","data":{}})");
+    std::string url = server.getUrl();
+
+    SessionPool::ENABLED = false;
+    test::print("pool off", test::summarize(run(url, count)));
+    std::printf("%-32s %d\n", "connections", server.connections.load());
+
+    SessionPool::ENABLED = true;
+    int before           = server.connections;
+    test::print("pool on", test::summarize(run(url, count)));
+    std::printf("%-32s %d\n", "connections",
+                server.connections.load() - before);
+    return 0;
+}
@@ -0,0 +1,73 @@
+// 比较在主线程中解码 (原有的 setImageFromMem) 与在子线程中解码并缩小后
+// 主线程中每张封面的耗时
+// 用法: bench_image_decode [图片] [显示宽度 (像素)] [重复次数]
+// 没有显卡时: EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "gl_context.hpp"
+#include "utils/image_decoder.hpp"
+
+/// 与 nanovg 的 nvgCreateImageRGBA 相同的上传方式 (不生成 mipmap)
+static void upload(const ImageData& image) {
+    GLuint tex;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width, image.height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // 等待上传结束，避免驱动延迟复制数据
+    glFinish();
+    glDeleteTextures(1, &tex);
+}
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : TEST_DATA_DIR "/cover.jpg";
+    float width      = argc > 2 ? std::atof(argv[2]) : 320;
+    int count        = argc > 3 ? std::atoi(argv[3]) : 50;
+
+    std::ifstream file(path, std::ios::binary);
+    CHECK(file);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string data = buffer.str();
+    GLContext context(1280, 720);
+
+    // 原有方式: 主线程解码原图并上传
+    std::vector<double> before;
+    for (int i = 0; i < count; i++) {
+        test::Timer timer;
+        auto image = decodeImage(data, 0, 0);
+        CHECK(image);
+        upload(*image);
+        before.push_back(timer.elapsed());
+    }
+
+    // 子线程解码并缩小，主线程只上传
+    std::vector<double> worker, main;
+    ImageData last;
+    for (int i = 0; i < count; i++) {
+        test::Timer decode;
+        auto image = decodeImage(data, width, 0);
+        CHECK(image);
+        worker.push_back(decode.elapsed());
+        test::Timer timer;
+        upload(*image);
+        main.push_back(timer.elapsed());
+        last = *image;
+    }
+
+    std::printf("%s: %.1f KB, display width %.0f px, uploaded %dx%d\n",
+                path.c_str(), data.size() / 1024.0, width, last.width,
+                last.height);
+    test::print("ui thread, before", test::summarize(before));
+    test::print("ui thread, after", test::summarize(main));
+    test::print("worker thread, after", test::summarize(worker));
+    return 0;
+}
@@ -0,0 +1,172 @@
+// 比较流式解析与先构建 json 对象再转换 (HTTP::parseResult 原有的方式)
+// 的耗时与堆内存峰值
+// 用法: bench_json_stream [重复次数]
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "bilibili/result/dynamic_video.h"
+#include "bilibili/result/video_detail_result.h"
+#include "test.hpp"
+
+using namespace bilibili;
+
+/// 统计当前与峰值的堆内存使用量
+static std::atomic<size_t> heapCurrent{0};
+static std::atomic<size_t> heapPeak{0};
+
+void* operator new(size_t size) {
+    // 在分配的内存前记录大小，释放时扣除
+    auto* p = (size_t*)std::malloc(size + sizeof(max_align_t));
+    if (!p) throw std::bad_alloc();
+    *p          = size;
+    size_t now  = heapCurrent += size;
+    size_t peak = heapPeak;
+    while (now > peak && !heapPeak.compare_exchange_weak(peak, now)) {
+    }
+    return (char*)p + sizeof(max_align_t);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    auto* p = (size_t*)((char*)ptr - sizeof(max_align_t));
+    heapCurrent -= *p;
+    std::free(p);
+}
+
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+
+/// 动态页的视频列表，接口返回的大部分字段不会被使用
+static std::string dynamicFixture(int count) {
+    nlohmann::json items = nlohmann::json::array();
+    for (int i = 0; i < count; i++) {
+        items.push_back({
+            {"aid", 100000 + i},
+            {"bvid", "BV1xx411c7m" + std::to_string(i)},
+            {"cid", 200000 + i},
+            {"pic", "https://i0.hdslb.com/bfs/archive/" +
+                        std::string(40, 'a' + i % 26) + ".jpg"},
+            {"title", "视频标题 " + std::to_string(i)},
+            {"desc", std::string(300, 'd')},
+            {"duration", 300 + i},
+            {"pubdate", 1670000000 + i},
+            {"ctime", 1670000000 + i},
+            {"tid", 17},
+            {"tname", "单机游戏"},
+            {"copyright", 1},
+            {"short_link", "https://b23.tv/BV1xx411c7m" + std::to_string(i)},
+            {"rights", {{"bp", 0}, {"elec", 0}, {"download", 1}}},
+            {"owner", {{"mid", i}, {"name", "up" + std::to_string(i)},
+                       {"face", "https://i0.hdslb.com/bfs/face/x.jpg"}}},
+            {"stat",
+             {{"aid", 100000 + i}, {"view", 12345}, {"danmaku", 67},
+              {"reply", 89}, {"favorite", 10}, {"coin", 11}, {"share", 12},
+              {"like", 13}}},
+            {"dimension", {{"width", 1920}, {"height", 1080}, {"rotate", 0}}},
+        });
+    }
+    nlohmann::json res = {
+        {"code", 0},
+        {"message", "0"},
+        {"ttl", 1},
+        {"data",
+         {{"items", items},
+          {"has_more", true},
+          {"offset", "123"},
+          {"update_baseline", "456"},
+          {"update_num", 0}}},
+    };
+    return res.dump();
+}
+
+static nlohmann::json comment(int i, int replies) {
+    nlohmann::json res = {
+        {"rpid", i},
+        {"ctime", 1670000000 + i},
+        {"like", i * 3},
+        {"member",
+         {{"mid", std::to_string(i)},
+          {"uname", "user" + std::to_string(i)},
+          {"avatar", "https://i0.hdslb.com/bfs/face/x.jpg"},
+          {"sign", std::string(60, 's')},
+          {"level_info", {{"current_level", 5}}},
+          {"vip", {{"vipType", 0}, {"vipStatus", 0}}}}},
+        {"content",
+         {{"message", "评论内容 " + std::string(120, 'c')},
+          {"members", nlohmann::json::array()},
+          {"jump_url", nlohmann::json::object()}}},
+        {"replies", nullptr},
+    };
+    if (replies > 0) {
+        res["replies"] = nlohmann::json::array();
+        for (int j = 0; j < replies; j++)
+            res["replies"].push_back(comment(i * 10 + j, 0));
+    }
+    return res;
+}
+
+/// 一页评论，每条评论带有几条回复
+static std::string commentFixture(int count) {
+    nlohmann::json replies = nlohmann::json::array();
+    for (int i = 0; i < count; i++) replies.push_back(comment(i, 3));
+    nlohmann::json res = {
+        {"code", 0},
+        {"message", "0"},
+        {"data",
+         {{"cursor",
+           {{"all_count", 1000},
+            {"mode", 3},
+            {"next", 2},
+            {"prev", 0},
+            {"is_end", false}}},
+          {"replies", replies},
+          {"top_replies", nullptr}}},
+    };
+    return res.dump();
+}
+
+template <typename T>
+static void parseStream(const std::string& text) {
+    T data;
+    CHECK(stream::parseResponse(text, data));
+}
+
+template <typename T>
+static void parseDom(const std::string& text) {
+    nlohmann::json res = nlohmann::json::parse(text);
+    T data             = res.at("data").get<T>();
+}
+
+/// 重复解析 count 次，输出耗时与单次解析时的堆内存峰值
+static void run(const char* name, const std::string& text, int count,
+                void (*parse)(const std::string&)) {
+    size_t base = heapCurrent;
+    heapPeak    = base;
+    parse(text);
+    size_t peak = heapPeak - base;
+
+    std::vector<double> samples;
+    for (int i = 0; i < count; i++) {
+        test::Timer timer;
+        parse(text);
+        samples.push_back(timer.elapsed());
+    }
+    test::print(name, test::summarize(samples));
+    std::printf("%-32s peak heap %.1f KB\n", "", peak / 1024.0);
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    std::string dynamic = dynamicFixture(100);
+    std::printf("dynamic video list: %.1f KB\n", dynamic.size() / 1024.0);
+    run("  stream", dynamic, count, parseStream<DynamicVideoListResultWrapper>);
+    run("  dom", dynamic, count, parseDom<DynamicVideoListResultWrapper>);
+
+    std::string comments = commentFixture(20);
+    std::printf("comment page: %.1f KB\n", comments.size() / 1024.0);
+    run("  stream", comments, count, parseStream<VideoCommentResultWrapper>);
+    run("  dom", comments, count, parseDom<VideoCommentResultWrapper>);
+    return 0;
+}
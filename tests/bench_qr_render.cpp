@@ -0,0 +1,62 @@
+// 比较直接写入 RGBA 数据与先生成 SVG 再由 lunasvg 渲染 (QRImage 原有的方式)
+// 生成二维码图片的耗时，两种方式上传纹理的开销相同，不计入
+// 用法: bench_qr_render [重复次数]
+
+#include <lunasvg.h>
+#include <pystring.h>
+
+#include "test.hpp"
+#include "utils/qr_helper.hpp"
+
+using qrcodegen::QrCode;
+
+/// 与扫码登录的链接长度相近
+static const char* CONTENT =
+    "https://passport.bilibili.com/h5-app/passport/login/scan?navhide=1&"
+    "qrcode_key=0123456789abcdef0123456789abcdef&from=";
+
+static const unsigned char DARK[4]  = {48, 48, 48, 255};
+static const unsigned char LIGHT[4] = {235, 235, 235, 255};
+
+/// 原有的方式：SVG 字符串替换颜色后解析并渲染
+static void renderSVG(const QrCode& qr, int size) {
+    std::string svg = qr.toSvgString(1);
+    svg             = pystring::replace(svg, "#000000", "#303030");
+    svg             = pystring::replace(svg, "#FFFFFF", "#EBEBEB");
+    auto document   = lunasvg::Document::loadFromData(svg);
+    CHECK(document);
+    auto bitmap = document->renderToBitmap(size, size);
+    bitmap.convertToRGBA();
+    CHECK(bitmap.width() == (uint32_t)size);
+}
+
+static void renderDirect(const QrCode& qr, int size) {
+    std::vector<unsigned char> pixels((size_t)size * size * 4);
+    renderQRCode(qr, 1, size, DARK, LIGHT, pixels.data());
+}
+
+static void run(const char* name, const QrCode& qr, int size, int count,
+                void (*render)(const QrCode&, int)) {
+    render(qr, size);
+    std::vector<double> samples;
+    for (int i = 0; i < count; i++) {
+        test::Timer timer;
+        render(qr, size);
+        samples.push_back(timer.elapsed());
+    }
+    test::print(name, test::summarize(samples));
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 200;
+    QrCode qr = QrCode::encodeText(CONTENT, QrCode::Ecc::LOW);
+    std::printf("%d modules\n", qr.getSize());
+
+    // 不同窗口缩放下登录二维码的像素尺寸
+    for (int size : {200, 400, 800}) {
+        std::printf("%dx%d\n", size, size);
+        run("  svg + lunasvg", qr, size, count, renderSVG);
+        run("  direct rgba", qr, size, count, renderDirect);
+    }
+    return 0;
+}
@@ -0,0 +1,238 @@
+// 回放滚动列表的过程，比较按提交顺序下载 (原有方式) 与按照与可见区域的
+// 距离下载时，滚动停止后到所有可见封面都显示出来的时间
+// 用法: bench_scroll_replay [下载线程数] [单张封面的下载耗时 (毫秒)]
+// 模拟卡片的回收、取消与按滑动速度的预加载，使用模拟的时间，不发送网络请求
+
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+
+#include "test.hpp"
+#include "utils/image_queue.hpp"
+
+/// 与 RecyclingGrid 中的封面卡片大致相同的布局 (像素)
+static const int COLUMNS         = 4;
+static const double ROW_HEIGHT   = 230;
+static const double VIEW_HEIGHT  = 720;
+static const double FRAME        = 1000.0 / 60;
+static const double MAX_DURATION = 60000;
+
+/// 与 RecyclingGrid 的 preFetchLine, prefetchTime 与 maxPrefetchLine 相同
+static const int PRELOAD_ROWS    = 1;
+static const double PREFETCH     = 0.6;
+static const int MAX_PREFETCH    = 6;
+static const size_t PREFETCH_MAX = 24;
+
+/// 一张封面的下载请求
+struct Request {
+    int cell;
+    bool prefetch = false;  // 预加载的请求，不会被取消
+    std::atomic<float> priority{0};
+    bool cancelled = false;
+    double finish  = -1;  // 下载结束的时间
+};
+using RequestPtr = std::shared_ptr<Request>;
+
+/// 滚动轨迹，返回某一时刻的滚动位置与滚动是否已经停止
+using Trace = std::function<double(double time, bool& stopped)>;
+
+/// 一次快速滑动：初速度按指数衰减，与触摸屏上的惯性滚动相同
+static Trace flick(double velocity, double decay, int times, double gap) {
+    return [=](double time, bool& stopped) {
+        double position = 0, start = 0;
+        double duration = std::log(velocity / 20) * decay;
+        for (int i = 0; i < times; i++) {
+            double t = std::min(std::max(time - start, 0.0), duration);
+            position += velocity * decay * (1 - std::exp(-t / decay)) / 1000;
+            start += duration + gap;
+        }
+        stopped = time >= start - gap;
+        return position;
+    };
+}
+
+/// 匀速滚动，与按住方向键翻页相同
+static Trace steady(double speed, double duration) {
+    return [=](double time, bool& stopped) {
+        stopped = time >= duration;
+        return speed * std::min(time, duration) / 1000;
+    };
+}
+
+/// 下载队列，fifo 为原有的按提交顺序下载
+class Queue {
+public:
+    explicit Queue(bool fifo) : fifo(fifo) {}
+
+    void push(const RequestPtr& item) {
+        if (fifo)
+            items.push_back(item);
+        else
+            queue.push(item);
+    }
+
+    bool pop(RequestPtr& item) {
+        if (!fifo) return queue.pop(item);
+        if (items.empty()) return false;
+        item = items.front();
+        items.pop_front();
+        return true;
+    }
+
+private:
+    bool fifo;
+    std::deque<RequestPtr> items;
+    ImageQueue<RequestPtr> queue;
+};
+
+struct Result {
+    double wait      = 0;  // 滚动停止后等待所有可见封面显示的时间
+    size_t downloads = 0;  // 开始下载的封面数量
+};
+
+/// 回放滚动轨迹，模拟 RecyclingGrid 与 ImageHelper 的下载过程
+static Result replay(const Trace& trace, bool fifo, int threads,
+                     double latency) {
+    Queue queue(fifo);
+    std::map<int, RequestPtr> cells;  // 当前存在的卡片与对应的请求
+    std::map<int, double> shown;      // 卡片显示封面的时间
+    std::set<int> downloaded;         // 已经下载的封面 (BitmapCache)
+    std::set<int> prefetching;
+    std::vector<RequestPtr> running(threads);
+    Result result;
+    double stopTime = -1, lastTop = 0;
+    unsigned int seed = 1;
+
+    for (double time = 0; time < MAX_DURATION; time += FRAME) {
+        bool stopped;
+        double top    = trace(time, stopped);
+        double bottom = top + VIEW_HEIGHT;
+        if (stopped && stopTime < 0) stopTime = time;
+
+        // 下载结束的请求
+        for (auto& item : running) {
+            if (!item || item->cancelled || item->finish > time) continue;
+            downloaded.insert(item->cell);
+            if (item->prefetch)
+                prefetching.erase(item->cell);
+            else
+                shown[item->cell] = time;
+            item = nullptr;
+        }
+
+        // 离开可见区域与预加载行的卡片被回收，取消请求
+        int firstRow = std::max(0, (int)(top / ROW_HEIGHT) - PRELOAD_ROWS);
+        int lastRow  = (int)(bottom / ROW_HEIGHT) + PRELOAD_ROWS;
+        int first = firstRow * COLUMNS, last = (lastRow + 1) * COLUMNS;
+        for (auto it = cells.begin(); it != cells.end();) {
+            if (it->first >= first && it->first < last) {
+                it++;
+                continue;
+            }
+            if (it->second) it->second->cancelled = true;
+            shown.erase(it->first);
+            it = cells.erase(it);
+        }
+        // 新的卡片请求封面，已经预加载的封面直接显示
+        for (int i = first; i < last; i++) {
+            if (cells.count(i)) continue;
+            if (downloaded.count(i)) {
+                cells[i] = nullptr;
+                shown[i] = time;
+                continue;
+            }
+            auto item  = std::make_shared<Request>();
+            item->cell = i;
+            cells[i]   = item;
+            queue.push(item);
+        }
+        // 与 RecyclingGrid::updateImagePriority 相同，更新与可见区域的距离
+        for (auto& i : cells) {
+            if (!i.second) continue;
+            double y = (i.first / COLUMNS) * ROW_HEIGHT;
+            i.second->priority =
+                std::max({0.0, top - (y + ROW_HEIGHT), y - bottom});
+        }
+        // 与 RecyclingGrid::prefetchImages 相同，按照滑动速度预加载
+        double speed = (top - lastTop) * 1000 / FRAME;
+        lastTop      = top;
+        if (speed > 0) {
+            int rows = std::min((int)(speed * PREFETCH / ROW_HEIGHT) + 1,
+                                MAX_PREFETCH);
+            for (int i = last; i < last + rows * COLUMNS; i++) {
+                if (prefetching.size() >= PREFETCH_MAX) break;
+                if (prefetching.count(i) || downloaded.count(i)) continue;
+                prefetching.insert(i);
+                auto item      = std::make_shared<Request>();
+                item->cell     = i;
+                item->prefetch = true;
+                item->priority = ((i - last) / COLUMNS + 1) * ROW_HEIGHT;
+                queue.push(item);
+            }
+        }
+
+        // 空闲或请求被取消的线程开始下一个请求
+        for (auto& item : running) {
+            if (item && !item->cancelled) continue;
+            item = nullptr;
+            RequestPtr next;
+            while (queue.pop(next)) {
+                // 还没有开始下载就被取消的请求直接丢弃
+                if (next->cancelled) continue;
+                // 下载耗时在 latency 上下浮动
+                seed         = seed * 1103515245 + 12345;
+                double noise = ((seed >> 16) % 1000) / 1000.0 - 0.5;
+                next->finish = time + latency * (1 + noise * 0.6);
+                item         = next;
+                result.downloads++;
+                break;
+            }
+        }
+
+        if (stopTime < 0) continue;
+        // 与可见区域相交的卡片都显示了封面
+        double end = stopTime;
+        bool done  = true;
+        for (int i = (int)(top / ROW_HEIGHT) * COLUMNS;
+             i < ((int)(bottom / ROW_HEIGHT) + 1) * COLUMNS; i++) {
+            auto it = shown.find(i);
+            if (it == shown.end()) {
+                done = false;
+                break;
+            }
+            end = std::max(end, it->second);
+        }
+        if (done) {
+            result.wait = end - stopTime;
+            return result;
+        }
+    }
+    result.wait = MAX_DURATION;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    int threads    = argc > 1 ? std::atoi(argv[1]) : 4;
+    double latency = argc > 2 ? std::atof(argv[2]) : 150;
+    std::printf("%d threads, %.0f ms per cover\n", threads, latency);
+
+    const std::vector<std::pair<const char*, Trace>> traces = {
+        {"one flick", flick(8000, 400, 1, 0)},
+        {"three flicks", flick(8000, 400, 3, 150)},
+        {"page down, 2s", steady(1500, 2000)},
+        {"slow scroll, 4s", steady(300, 4000)},
+    };
+    for (auto& trace : traces) {
+        Result before = replay(trace.second, true, threads, latency);
+        Result after  = replay(trace.second, false, threads, latency);
+        std::printf("%-20s fifo %7.0f ms (%3zu downloads)  "
+                    "nearest first %7.0f ms (%3zu downloads)\n",
+                    trace.first, before.wait, before.downloads, after.wait,
+                    after.downloads);
+    }
+    return 0;
+}
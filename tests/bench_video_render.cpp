@@ -0,0 +1,235 @@
+// 用 OpenGL ES 模拟 MPVCore::openglDraw 每一帧的开销
+// 比较每一帧都渲染视频画面 (原有方式) 与只在 mpv 有新画面时渲染
+// 以及全屏时直接渲染到窗口与先渲染到 texture 再绘制到窗口
+// mpv 的渲染用一次 YUV 转 RGB 并缩放到窗口尺寸的绘制代替，新画面到来时上传
+// 1080p 的 YUV420 数据，两种方式上传的次数相同
+// 用法: bench_video_render [窗口宽] [窗口高] [界面帧数]
+// 没有显卡时: EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1
+
+#include <string>
+
+#include "gl_context.hpp"
+
+static const int VIDEO_WIDTH  = 1920;
+static const int VIDEO_HEIGHT = 1080;
+static const int UI_FPS       = 60;
+
+enum class Mode {
+    EVERY_FRAME,  // 每一帧都渲染到 texture 再绘制到窗口 (原有方式)
+    NEW_FRAMES,   // 只在有新画面时渲染到 texture，每一帧绘制到窗口
+    DIRECT,       // 每一帧直接渲染到窗口
+};
+
+/// 覆盖整个视口的三角形
+static const char* VERTEX =
+    "#version 300 es\n"
+    "out vec2 uv;\n"
+    "void main() {\n"
+    "    int i = gl_VertexID;\n"
+    "    vec2 p = vec2(float((i << 1) & 2), float(i & 2));\n"
+    "    uv = p;\n"
+    "    gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);\n"
+    "}\n";
+
+/// 代替 mpv 的渲染：采样三个平面并按照 BT.709 转换为 RGB
+static const char* YUV =
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "in vec2 uv;\n"
+    "out vec4 color;\n"
+    "uniform sampler2D planeY, planeU, planeV;\n"
+    "void main() {\n"
+    "    float y = texture(planeY, uv).r;\n"
+    "    float u = texture(planeU, uv).r - 0.5;\n"
+    "    float v = texture(planeV, uv).r - 0.5;\n"
+    "    color = vec4(y + 1.5748 * v, y - 0.1873 * u - 0.4681 * v,\n"
+    "                 y + 1.8556 * u, 1.0);\n"
+    "}\n";
+
+/// 与 MPVCore 中将 texture 绘制到窗口的着色器相同
+static const char* COMPOSITE =
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "in vec2 uv;\n"
+    "out vec4 color;\n"
+    "uniform sampler2D ourTexture;\n"
+    "uniform float Alpha;\n"
+    "void main() {\n"
+    "    color = texture(ourTexture, uv);\n"
+    "    color.a = Alpha;\n"
+    "}\n";
+
+static GLuint compile(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+    GLint success = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char log[512];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::fprintf(stderr, "%s\n", log);
+    }
+    CHECK(success);
+    return shader;
+}
+
+static GLuint program(const char* fragment) {
+    GLuint prog = glCreateProgram();
+    glAttachShader(prog, compile(GL_VERTEX_SHADER, VERTEX));
+    glAttachShader(prog, compile(GL_FRAGMENT_SHADER, fragment));
+    glLinkProgram(prog);
+    GLint success = 0;
+    glGetProgramiv(prog, GL_LINK_STATUS, &success);
+    CHECK(success);
+    return prog;
+}
+
+static GLuint texture(GLenum format, int width, int height) {
+    GLuint tex;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexStorage2D(GL_TEXTURE_2D, 1, format, width, height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return tex;
+}
+
+/// 模拟的 mpv 渲染与 MPVCore 的 texture
+class VideoRenderer {
+public:
+    VideoRenderer(int width, int height) : width(width), height(height) {
+        yuvProgram       = program(YUV);
+        compositeProgram = program(COMPOSITE);
+        planes[0]        = texture(GL_R8, VIDEO_WIDTH, VIDEO_HEIGHT);
+        planes[1]        = texture(GL_R8, VIDEO_WIDTH / 2, VIDEO_HEIGHT / 2);
+        planes[2]        = texture(GL_R8, VIDEO_WIDTH / 2, VIDEO_HEIGHT / 2);
+        glUseProgram(yuvProgram);
+        const char* names[] = {"planeY", "planeU", "planeV"};
+        for (int i = 0; i < 3; i++)
+            glUniform1i(glGetUniformLocation(yuvProgram, names[i]), i);
+        data.resize(VIDEO_WIDTH * VIDEO_HEIGHT);
+
+        // 与 MPVCore::setFrameSize 相同，texture 的尺寸与窗口相同
+        mediaTexture = texture(GL_RGBA8, width, height);
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                               GL_TEXTURE_2D, mediaTexture, 0);
+        CHECK(glCheckFramebufferStatus(GL_FRAMEBUFFER) ==
+              GL_FRAMEBUFFER_COMPLETE);
+        glGenVertexArrays(1, &vao);
+    }
+
+    /// 解码出新的一帧，上传 YUV 数据
+    void upload(int frame) {
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = (unsigned char)(i * 7 + frame * 13);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (int i = 0; i < 3; i++) {
+            int w = i == 0 ? VIDEO_WIDTH : VIDEO_WIDTH / 2;
+            int h = i == 0 ? VIDEO_HEIGHT : VIDEO_HEIGHT / 2;
+            glBindTexture(GL_TEXTURE_2D, planes[i]);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_RED,
+                            GL_UNSIGNED_BYTE, data.data());
+        }
+    }
+
+    /// mpv_render_context_render，fbo 为 0 时直接渲染到窗口
+    void render(GLuint fbo) {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glViewport(0, 0, width, height);
+        glDisable(GL_BLEND);
+        glUseProgram(yuvProgram);
+        for (int i = 0; i < 3; i++) {
+            glActiveTexture(GL_TEXTURE0 + i);
+            glBindTexture(GL_TEXTURE_2D, planes[i]);
+        }
+        glActiveTexture(GL_TEXTURE0);
+        glBindVertexArray(vao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+
+    /// MPVCore::openglDraw 中将 texture 绘制到窗口
+    void composite(float alpha) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, width, height);
+        glUseProgram(compositeProgram);
+        glBindTexture(GL_TEXTURE_2D, mediaTexture);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glUniform1f(glGetUniformLocation(compositeProgram, "Alpha"), alpha);
+        glBindVertexArray(vao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+
+    /// 绘制界面的一帧，返回是否渲染了视频画面，videoFps 为 0 时视频暂停
+    bool frame(int index, int videoFps, Mode mode) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glClear(GL_COLOR_BUFFER_BIT);
+        int video = videoFps * index / UI_FPS;
+        if (video != lastVideo) {
+            lastVideo = video;
+            this->upload(video);
+            redraw = true;
+        }
+        if (mode == Mode::DIRECT) {
+            // 窗口每一帧都会重新绘制，所以每一帧都需要渲染
+            this->render(0);
+            return true;
+        }
+        bool rendered = mode == Mode::EVERY_FRAME || redraw;
+        if (rendered) this->render(framebuffer);
+        redraw = false;
+        this->composite(1.0f);
+        return rendered;
+    }
+
+    int width, height;
+    int lastVideo = -1;
+    bool redraw   = true;
+
+private:
+    GLuint yuvProgram, compositeProgram;
+    GLuint planes[3];
+    GLuint mediaTexture, framebuffer, vao;
+    std::vector<unsigned char> data;
+};
+
+static void run(const char* name, VideoRenderer& renderer, int frames,
+                int videoFps, Mode mode) {
+    renderer.lastVideo = -1;
+    std::vector<double> samples;
+    int renders = 0;
+    for (int i = 0; i < frames; i++) {
+        test::Timer timer;
+        renders += renderer.frame(i, videoFps, mode);
+        // 等待绘制结束，软件渲染时即为 CPU 的耗时
+        glFinish();
+        samples.push_back(timer.elapsed());
+    }
+    test::print(name, test::summarize(samples));
+    std::printf("%-32s %d renders\n", "", renders);
+}
+
+int main(int argc, char** argv) {
+    int width  = argc > 1 ? std::atoi(argv[1]) : 1280;
+    int height = argc > 2 ? std::atoi(argv[2]) : 720;
+    int frames = argc > 3 ? std::atoi(argv[3]) : 240;
+    GLContext context(width, height);
+    VideoRenderer renderer(width, height);
+    std::printf("window %dx%d, ui %d fps, %d frames\n", width, height, UI_FPS,
+                frames);
+
+    for (int fps : {60, 30, 24, 0}) {
+        if (fps > 0)
+            std::printf("%d fps video\n", fps);
+        else
+            std::printf("paused\n");
+        run("  every frame", renderer, frames, fps, Mode::EVERY_FRAME);
+        run("  new frames only", renderer, frames, fps, Mode::NEW_FRAMES);
+        // 全屏且不透明时才会直接渲染，暂停时没有意义
+        if (fps > 0) run("  direct", renderer, frames, fps, Mode::DIRECT);
+    }
+    return 0;
+}
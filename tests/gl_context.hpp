@@ -0,0 +1,54 @@
+#pragma once
+
+#include <EGL/egl.h>
+#include <GLES3/gl3.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "test.hpp"
+
+/// 不需要窗口的 OpenGL ES 3 环境，用于测量纹理上传与绘制的耗时
+/// 没有显卡时可以使用 Mesa 的软件渲染:
+/// EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./bench_xxx
+class GLContext {
+public:
+    GLContext(int width, int height) {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        CHECK(eglInitialize(display, nullptr, nullptr));
+        const EGLint configAttrs[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE,
+            EGL_OPENGL_ES3_BIT, EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8, EGL_STENCIL_SIZE, 8,
+            EGL_NONE};
+        EGLConfig config;
+        EGLint count = 0;
+        CHECK(eglChooseConfig(display, configAttrs, &config, 1, &count) &&
+              count == 1);
+        const EGLint surfaceAttrs[] = {EGL_WIDTH, width, EGL_HEIGHT, height,
+                                       EGL_NONE};
+        surface = eglCreatePbufferSurface(display, config, surfaceAttrs);
+        CHECK(surface != EGL_NO_SURFACE);
+        eglBindAPI(EGL_OPENGL_ES_API);
+        const EGLint contextAttrs[] = {EGL_CONTEXT_CLIENT_VERSION, 3,
+                                       EGL_NONE};
+        context =
+            eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttrs);
+        CHECK(context != EGL_NO_CONTEXT);
+        CHECK(eglMakeCurrent(display, surface, surface, context));
+        std::printf("renderer: %s\n", glGetString(GL_RENDERER));
+    }
+
+    ~GLContext() {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                       EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+        eglDestroySurface(display, surface);
+        eglTerminate(display);
+    }
+
+private:
+    EGLDisplay display;
+    EGLSurface surface;
+    EGLContext context;
+};
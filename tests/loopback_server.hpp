@@ -0,0 +1,74 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "test.hpp"
+
+/// 支持 keep-alive 的最小 HTTP/1.1 服务器，所有请求返回同一个结果
+/// 新连接在 delay 毫秒后才开始响应，用于模拟握手开销或较慢的节点
+class LoopbackServer {
+public:
+    explicit LoopbackServer(int delay, std::string body = R"({"code":0})")
+        : delay(delay), body(std::move(body)) {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        CHECK(bind(fd, (sockaddr*)&addr, sizeof(addr)) == 0);
+        CHECK(listen(fd, 64) == 0);
+        socklen_t len = sizeof(addr);
+        getsockname(fd, (sockaddr*)&addr, &len);
+        port = ntohs(addr.sin_port);
+        std::thread([this]() { this->accept(); }).detach();
+    }
+
+    std::string getUrl(const std::string& path = "/x/test") const {
+        return "http://127.0.0.1:" + std::to_string(port) + path;
+    }
+
+    std::atomic<int> connections{0};
+
+private:
+    int fd;
+    int port;
+    int delay;
+    std::string body;
+
+    void accept() {
+        while (true) {
+            int client = ::accept(fd, nullptr, nullptr);
+            if (client < 0) return;
+            connections++;
+            std::thread([this, client]() { this->serve(client); }).detach();
+        }
+    }
+
+    void serve(int client) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        const std::string response =
+            "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+            "Connection: keep-alive\r\nContent-Length: " +
+            std::to_string(body.size()) + "\r\n\r\n" + body;
+        std::string buffer;
+        char data[4096];
+        while (true) {
+            ssize_t n = recv(client, data, sizeof(data), 0);
+            if (n <= 0) break;
+            buffer.append(data, n);
+            size_t end;
+            while ((end = buffer.find("\r\n\r\n")) != std::string::npos) {
+                buffer.erase(0, end + 4);
+                send(client, response.data(), response.size(), MSG_NOSIGNAL);
+            }
+        }
+        close(client);
+    }
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/// 条件不成立时输出位置并以失败退出
+#define CHECK(cond)                                                       \
+    do {                                                                  \
+        if (!(cond)) {                                                    \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, \
+                         __LINE__, #cond);                                \
+            std::exit(1);                                                 \
+        }                                                                 \
+    } while (0)
+
+namespace test {
+
+/// 从调用时开始计时，返回经过的毫秒数
+class Timer {
+public:
+    double elapsed() const {
+        return std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+};
+
+/// 一组耗时的平均值与百分位数
+struct Summary {
+    double mean = 0;
+    double p50  = 0;
+    double p99  = 0;
+    double max  = 0;
+};
+
+inline Summary summarize(std::vector<double> samples) {
+    Summary s;
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    for (auto i : samples) s.mean += i;
+    s.mean /= samples.size();
+    s.p50 = samples[(samples.size() - 1) / 2];
+    s.p99 = samples[(samples.size() - 1) * 99 / 100];
+    s.max = samples.back();
+    return s;
+}
+
+inline void print(const char* name, const Summary& s) {
+    std::printf("%-32s mean %8.3f  p50 %8.3f  p99 %8.3f  max %8.3f ms\n",
+                name, s.mean, s.p50, s.p99, s.max);
+}
+
+}  // namespace test
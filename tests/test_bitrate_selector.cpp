@@ -0,0 +1,135 @@
+// 按照网速轨迹模拟 mpv 的下载与播放，检查 BitrateSelector 选择的码率
+// 缓存已满时 mpv 只按照播放的速度下载，此时的下载速度不能作为带宽估计
+
+#include <functional>
+
+#include "test.hpp"
+#include "utils/bitrate_selector.hpp"
+
+static const std::vector<unsigned int> BITRATES = {500000, 1000000, 2000000,
+                                                   4000000, 8000000};
+static const int64_t MIB = 1024 * 1024;
+static const double TICK = 0.5;  // 与 UPDATE_PROGRESS 的间隔相近
+
+/// 网速轨迹，返回某一时刻的带宽 (bps)
+using Trace = std::function<double(double time)>;
+
+struct Result {
+    size_t index   = 0;   // 结束时的码率序号
+    int stalls     = 0;   // 卡顿次数
+    int switches   = 0;   // 切换码率的次数
+    double topTime = -1;  // 第一次使用最高码率的时间
+    double settle  = -1;  // 最后一次切换码率的时间
+};
+
+/// 模拟播放 duration 秒，cache 为 mpv 的缓存上限
+/// reportIdle 为 false 时模拟 mpv 没有报告 demuxer-cache-idle
+static Result play(const Trace& trace, int64_t cache, double duration,
+                   bool reportIdle = true) {
+    BitrateSelector selector;
+    selector.setCacheSize(cache);
+    selector.setBitrates(BITRATES, 0, 0);
+    Result result;
+    double buffer = 0, stallTime = 0;
+
+    for (double time = TICK; time <= duration; time += TICK) {
+        // 下载：缓存已满时只补充播放消耗的部分
+        double bitrate  = BITRATES[selector.getIndex()];
+        double capacity = cache * 8.0 / bitrate;
+        double fetched =
+            std::min(trace(time) * TICK / bitrate, capacity - buffer);
+        buffer += fetched;
+        bool idle = reportIdle && buffer >= capacity;
+
+        // 播放：缓冲不足时卡顿，超过 STALL_TIME 时报告
+        if (buffer >= TICK) {
+            buffer -= TICK;
+            stallTime = 0;
+        } else {
+            if (stallTime == 0) result.stalls++;
+            stallTime += TICK;
+        }
+
+        size_t index = selector.getIndex();
+        size_t next  = selector.update(
+            time, (int64_t)(fetched * bitrate / 8 / TICK), buffer, idle);
+        if (stallTime >= BitrateSelector::STALL_TIME &&
+            stallTime < BitrateSelector::STALL_TIME + TICK)
+            next = selector.reportStall(time);
+        if (next != index) {
+            // 新的视频流从当前位置开始缓冲
+            buffer = 0;
+            result.switches++;
+            result.settle = time;
+        }
+        if (next == BITRATES.size() - 1 && result.topTime < 0)
+            result.topTime = time;
+    }
+    result.index = selector.getIndex();
+    return result;
+}
+
+static void print(const char* name, const Result& r) {
+    std::printf("%-24s index %zu, top at %5.1f s, %d switches, %d stalls\n",
+                name, r.index, r.topTime, r.switches, r.stalls);
+}
+
+/// 带宽充足时逐级提高到最高码率，缓存已满后不会因为下载变慢而降低
+static void testSteady() {
+    auto fast = [](double) { return 20e6; };
+    for (int64_t cache : {10 * MIB, 50 * MIB}) {
+        Result r = play(fast, cache, 300);
+        print(cache == 10 * MIB ? "steady, 10 MiB" : "steady, 50 MiB", r);
+        CHECK(r.index == BITRATES.size() - 1);
+        CHECK(r.topTime > 0 && r.topTime < 120);
+        CHECK(r.switches == (int)BITRATES.size() - 1);
+        CHECK(r.stalls == 0);
+    }
+
+    // 没有 demuxer-cache-idle 时按照缓冲时长判断缓存已满
+    Result r = play(fast, 10 * MIB, 300, false);
+    print("steady, no idle flag", r);
+    CHECK(r.index == BITRATES.size() - 1);
+    CHECK(r.switches == (int)BITRATES.size() - 1);
+}
+
+/// 带宽下降后在缓冲耗尽前降到带宽能够支持的码率，之后不再切换
+static void testDrop() {
+    auto drop = [](double time) { return time < 150 ? 20e6 : 3e6; };
+    Result r  = play(drop, 10 * MIB, 400);
+    print("20 -> 3 Mbps", r);
+    CHECK(r.index == 2);
+    CHECK(r.settle > 150 && r.settle < 180);
+    CHECK(r.stalls == 0);
+}
+
+/// 带宽在两个值之间波动时不会频繁切换
+static void testFluctuate() {
+    auto wave = [](double time) {
+        return (int)(time / 20) % 2 ? 6e6 : 12e6;
+    };
+    Result r = play(wave, 10 * MIB, 600);
+    print("6 / 12 Mbps every 20 s", r);
+    CHECK(r.switches <= 6);
+    CHECK(r.stalls <= 1);
+}
+
+/// 缓存已满或暂停时的下载速度不计入带宽估计
+static void testLimited() {
+    BitrateSelector selector;
+    selector.setBitrates(BITRATES, 4, 0);
+    for (int i = 1; i <= 10; i++) selector.update(i, 2500000, 5, false);
+    double estimate = selector.getEstimate();
+    CHECK(estimate > 19e6 && estimate < 21e6);
+    for (int i = 11; i <= 60; i++) selector.update(i, 1000000, 5, true);
+    CHECK(selector.getEstimate() == estimate);
+    CHECK(selector.getIndex() == 4);
+}
+
+int main() {
+    testSteady();
+    testDrop();
+    testFluctuate();
+    testLimited();
+    return 0;
+}
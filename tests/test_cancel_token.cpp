@@ -0,0 +1,66 @@
+#include "bilibili/util/cancel_token.hpp"
+#include "test.hpp"
+
+using namespace bilibili;
+
+/// 结束后不能再取消，取消时的回调不会执行
+static void testFinishThenCancel() {
+    int cancelled = 0;
+    auto handle   = CancelToken::create();
+    handle->onCancel([&cancelled]() { cancelled++; });
+    CHECK(handle->finish());
+    handle->cancel();
+    CHECK(cancelled == 0);
+    CHECK(!handle->isCancelled());
+}
+
+/// 取消后不能再结束，请求的回调不应执行
+static void testCancelThenFinish() {
+    int cancelled = 0;
+    auto handle   = CancelToken::create();
+    handle->onCancel([&cancelled]() { cancelled++; });
+    handle->cancel();
+    handle->cancel();
+    CHECK(cancelled == 1);
+    CHECK(!handle->finish());
+    CHECK(!handle->isFinished());
+}
+
+/// 延迟发起的请求
+static void testDelegate() {
+    // 取消时一同取消，child 不再执行回调
+    auto parent = CancelToken::create();
+    auto child  = CancelToken::create();
+    parent->delegate(child);
+    parent->cancel();
+    CHECK(child->isCancelled());
+    CHECK(!child->finish());
+
+    // child 结束时 parent 也结束，之后取消不会执行取消时的回调
+    int cancelled = 0;
+    parent        = CancelToken::create();
+    child         = CancelToken::create();
+    parent->onCancel([&cancelled]() { cancelled++; });
+    parent->delegate(child);
+    CHECK(child->finish());
+    CHECK(parent->isFinished());
+    parent->cancel();
+    CHECK(cancelled == 0);
+
+    // child 在关联之前已经结束
+    parent = CancelToken::create();
+    child  = CancelToken::create();
+    parent->onCancel([&cancelled]() { cancelled++; });
+    CHECK(child->finish());
+    parent->delegate(child);
+    CHECK(parent->isFinished());
+    parent->cancel();
+    CHECK(cancelled == 0);
+}
+
+int main() {
+    testFinishThenCancel();
+    testCancelThenFinish();
+    testDelegate();
+    return 0;
+}
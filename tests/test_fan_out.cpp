@@ -0,0 +1,63 @@
+#include <map>
+
+#include "bilibili/util/fan_out.hpp"
+#include "test.hpp"
+
+using namespace bilibili;
+
+using Result = std::map<int, int>;
+
+static void testResolve() {
+    int calls = 0;
+    Result data;
+    auto join = FanOut<Result>::create(3, [&](Result res) {
+        calls++;
+        data = res;
+    });
+    for (int i = 0; i < 3; i++) {
+        join->add(CancelToken::create());
+        join->resolve([i](Result& res) { res[i] = i * 10; });
+    }
+    CHECK(calls == 1);
+    CHECK(data.size() == 3);
+    CHECK(data[2] == 20);
+}
+
+static void testRejectCancelsSiblings() {
+    int errors = 0;
+    auto join  = FanOut<Result>::create(
+        3, [](Result) { CHECK(false); },
+        [&errors](const std::string&) { errors++; });
+    auto done    = CancelToken::create();
+    auto pending = CancelToken::create();
+    join->add(done);
+    join->add(pending);
+    join->resolve([](Result& res) { res[0] = 0; });
+    done->finish();
+
+    join->reject("error");
+    CHECK(errors == 1);
+    CHECK(pending->isCancelled());
+    CHECK(!done->isCancelled());
+
+    // 失败之后发起的请求立即取消，之后的结果与错误都被忽略
+    auto late = CancelToken::create();
+    join->add(late);
+    CHECK(late->isCancelled());
+    join->reject("error");
+    join->resolve(nullptr);
+    CHECK(errors == 1);
+}
+
+static void testEmpty() {
+    int calls = 0;
+    FanOut<Result>::create(0, [&calls](Result) { calls++; });
+    CHECK(calls == 1);
+}
+
+int main() {
+    testResolve();
+    testRejectCancelsSiblings();
+    testEmpty();
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "bilibili/result/dynamic_video.h"
+#include "test.hpp"
+
+using namespace bilibili;
+
+static const std::string OWNER =
+    R"("owner": {"mid": 1, "name": "owner", "face": ""})";
+static const std::string AUTHOR =
+    R"("author": {"mid": 2, "name": "author", "face": ""})";
+
+static std::string video(const std::string& users) {
+    return R"({"code": 0, "data": {"aid": 1, "bvid": "BV1", "pic": "",
+        "title": "t", "duration": 60, "pubdate": 0,
+        "stat": {"view": 10, "danmaku": 2}, )" +
+           users + "}}";
+}
+
+/// 流式解析与 json 解析的结果必须相同
+static void checkSame(const std::string& text) {
+    DynamicVideoResult stream, dom;
+    CHECK(stream::parseResponse(text, stream));
+    nlohmann::json::parse(text).at("data").get_to(dom);
+    CHECK(stream.owner.mid == dom.owner.mid);
+    CHECK(stream.owner.name == dom.owner.name);
+    CHECK(stream.stat.view == dom.stat.view);
+}
+
+static void testOwnerPrecedence() {
+    checkSame(video(OWNER));
+    checkSame(video(AUTHOR));
+    checkSame(video(OWNER + ", " + AUTHOR));
+    checkSame(video(AUTHOR + ", " + OWNER));
+
+    DynamicVideoResult res;
+    CHECK(stream::parseResponse(video(OWNER + ", " + AUTHOR), res));
+    CHECK(res.owner.name == "owner");
+}
+
+static void testErrors() {
+    DynamicVideoResult res;
+    // 缺少必须存在的字段
+    CHECK(!stream::parseResponse(R"({"code": 0, "data": {"aid": 1}})", res));
+    // code 不为 0
+    CHECK(!stream::parseResponse(R"({"code": -400, "data": null})", res));
+    // 类型不匹配
+    CHECK(!stream::parseResponse(video(R"("owner": "")"), res));
+}
+
+int main() {
+    testOwnerPrecedence();
+    testErrors();
+    return 0;
+}
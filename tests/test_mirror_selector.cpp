@@ -0,0 +1,78 @@
+// 多个本地服务器模拟不同速度的 CDN 节点
+
+#include <cstdio>
+#include <filesystem>
+#include <future>
+
+#include "loopback_server.hpp"
+#include "utils/mirror_selector.hpp"
+
+/// 等待测速结果写入磁盘，即所有测速都已结束
+static void waitSaved(const std::string& path) {
+    test::Timer timer;
+    while (!std::filesystem::exists(path)) {
+        CHECK(timer.elapsed() < MirrorSelector::PROBE_TIMEOUT * 4);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::filesystem::remove(path);
+}
+
+int main() {
+    MirrorSelector::PROBE_SIZE    = 64 * 1024;
+    MirrorSelector::PROBE_TIMEOUT = 2000;
+    MirrorSelector::FAST_SCORE    = 500;
+    MirrorSelector::HISTORY_PATH =
+        (std::filesystem::temp_directory_path() / "wiliwili_mirrors.json")
+            .string();
+    std::filesystem::remove(MirrorSelector::HISTORY_PATH);
+
+    std::string body(MirrorSelector::PROBE_SIZE, 'x');
+    LoopbackServer fast(0, body), slow(1000, body), medium(300, body);
+    std::vector<std::string> urls = {slow.getUrl(), fast.getUrl(),
+                                     medium.getUrl()};
+    auto& selector = MirrorSelector::instance();
+
+    // 没有历史得分时，第一个足够快的节点测速结束后就回调，不等待慢的节点
+    std::promise<std::vector<std::string>> ranked;
+    test::Timer timer;
+    selector.rank(urls, [&ranked](std::vector<std::string> res) {
+        ranked.set_value(res);
+    });
+    auto res       = ranked.get_future().get();
+    double elapsed = timer.elapsed();
+    std::printf("first rank: %.0f ms\n", elapsed);
+    CHECK(elapsed < 1000);
+    CHECK(res.size() == 3);
+    CHECK(res[0] == fast.getUrl());
+    waitSaved(MirrorSelector::HISTORY_PATH);
+
+    // 所有测速结束后按速度排序
+    res = selector.sort(urls);
+    CHECK((res == std::vector<std::string>{fast.getUrl(), medium.getUrl(),
+                                           slow.getUrl()}));
+
+    // 有历史得分且没有过期时立即回调，不再测速
+    int connections = fast.connections + slow.connections + medium.connections;
+    bool called     = false;
+    selector.rank(urls, [&called, &fast](std::vector<std::string> sorted) {
+        called = true;
+        CHECK(sorted[0] == fast.getUrl());
+    });
+    CHECK(called);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(fast.connections + slow.connections + medium.connections ==
+          connections);
+
+    // 得分过期时在后台重新测速
+    MirrorSelector::PROBE_INTERVAL = 0;
+    called                         = false;
+    selector.rank(urls, [&called](std::vector<std::string>) { called = true; });
+    CHECK(called);
+    waitSaved(MirrorSelector::HISTORY_PATH);
+
+    // 卡顿的节点排到后面
+    selector.reportStall(fast.getUrl());
+    std::filesystem::remove(MirrorSelector::HISTORY_PATH);
+    CHECK(selector.sort(urls).back() == fast.getUrl());
+    return 0;
+}
@@ -0,0 +1,203 @@
+#include <thread>
+
+#include "utils/network_admission.hpp"
+#include "test.hpp"
+
+using State = NetworkAdmission::State;
+
+static const int64_t FAST = 1024 * 1024;
+static const int64_t SLOW = 64 * 1024;
+
+/// 模拟的后台下载，记录开始的顺序
+struct Downloads {
+    std::vector<int> started;
+
+    NetworkAdmission::Task make(int id) {
+        return [this, id]() { started.push_back(id); };
+    }
+};
+
+static void testPauseWhileLoading() {
+    NetworkAdmission admission;
+    Downloads downloads;
+    std::vector<NetworkAdmission::Task> executed;
+    admission.setExecutor(
+        [&executed](NetworkAdmission::Task task) { executed.push_back(task); });
+
+    admission.submit(downloads.make(1));
+    CHECK(downloads.started.size() == 1);
+    admission.release();
+
+    admission.onMpvEvent(MpvEventEnum::START_FILE, 0);
+    admission.onMpvEvent(MpvEventEnum::LOADING_START, 0);
+    CHECK(admission.getState() == State::PAUSED);
+
+    // 缓冲时不会阻塞，请求排队等待
+    int deferred = 0;
+    admission.submit(downloads.make(2));
+    admission.submit(downloads.make(3));
+    admission.defer([&deferred]() { deferred++; });
+    CHECK(downloads.started.size() == 1);
+    CHECK(admission.waitCount == 2);
+    CHECK(admission.deferCount == 1);
+
+    // 缓冲期间的网速变化不会解除暂停
+    admission.onMpvEvent(MpvEventEnum::CACHE_SPEED_CHANGE, FAST);
+    CHECK(admission.getState() == State::PAUSED);
+
+    // 缓冲结束后按顺序开始，延迟的请求交给 executor
+    admission.onMpvEvent(MpvEventEnum::LOADING_END, FAST);
+    CHECK(admission.getState() == State::OPEN);
+    CHECK((downloads.started == std::vector<int>{1, 2, 3}));
+    CHECK(deferred == 0);
+    CHECK(executed.size() == 1);
+    executed[0]();
+    CHECK(deferred == 1);
+}
+
+static void testThrottle() {
+    NetworkAdmission admission;
+    Downloads downloads;
+    admission.onMpvEvent(MpvEventEnum::LOADING_END, SLOW);
+    CHECK(admission.getState() == State::THROTTLED);
+
+    admission.submit(downloads.make(1));
+    admission.submit(downloads.make(2));
+    admission.submit(downloads.make(3));
+    CHECK((downloads.started == std::vector<int>{1}));
+
+    // 每结束一个下载开始下一个
+    admission.release();
+    CHECK((downloads.started == std::vector<int>{1, 2}));
+
+    // 缓存已满时下载速度为 0，不再限流
+    admission.onMpvEvent(MpvEventEnum::CACHE_SPEED_CHANGE, 0);
+    CHECK(admission.getState() == State::OPEN);
+    CHECK((downloads.started == std::vector<int>{1, 2, 3}));
+}
+
+static void testLongPause() {
+    NetworkAdmission admission;
+    Downloads downloads;
+    int maxPause                = NetworkAdmission::MAX_PAUSE;
+    NetworkAdmission::MAX_PAUSE = 20;
+
+    admission.onMpvEvent(MpvEventEnum::LOADING_START, 0);
+    admission.submit(downloads.make(1));
+    admission.submit(downloads.make(2));
+    CHECK(downloads.started.empty());
+
+    // 缓冲时间过长，改为限流
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    admission.onMpvEvent(MpvEventEnum::CACHE_SPEED_CHANGE, SLOW);
+    CHECK(admission.getState() == State::THROTTLED);
+    CHECK((downloads.started == std::vector<int>{1}));
+
+    NetworkAdmission::MAX_PAUSE = maxPause;
+}
+
+/// 缓冲开始后 mpv 不再发送网速变化的事件，由定时器解除暂停
+static void testStalledLoading() {
+    NetworkAdmission admission;
+    Downloads downloads;
+    std::vector<std::pair<int, NetworkAdmission::Task>> timers;
+    admission.setTimer([&timers](int ms, NetworkAdmission::Task task) {
+        timers.emplace_back(ms, task);
+    });
+    int maxPause                = NetworkAdmission::MAX_PAUSE;
+    NetworkAdmission::MAX_PAUSE = 20;
+
+    int deferred = 0;
+    admission.onMpvEvent(MpvEventEnum::LOADING_START, 0);
+    admission.submit(downloads.make(1));
+    admission.submit(downloads.make(2));
+    admission.defer([&deferred]() { deferred++; });
+    CHECK(timers.size() == 1);
+    CHECK(timers[0].first == NetworkAdmission::MAX_PAUSE);
+
+    // 未到时间的定时检查不会解除暂停
+    timers[0].second();
+    CHECK(admission.getState() == State::PAUSED);
+    CHECK(downloads.started.empty());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    timers[0].second();
+    CHECK(admission.getState() == State::THROTTLED);
+    CHECK((downloads.started == std::vector<int>{1}));
+    CHECK(deferred == 1);
+
+    // 没有定时器时，提交新的请求时同样检查暂停的时间
+    NetworkAdmission other;
+    other.onMpvEvent(MpvEventEnum::LOADING_START, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    other.submit(downloads.make(3));
+    CHECK(other.getState() == State::THROTTLED);
+    CHECK((downloads.started == std::vector<int>{1, 3}));
+
+    NetworkAdmission::MAX_PAUSE = maxPause;
+}
+
+static void testStop() {
+    NetworkAdmission admission;
+    Downloads downloads;
+    int deferred = 0;
+    admission.onMpvEvent(MpvEventEnum::LOADING_START, 0);
+    admission.submit(downloads.make(1));
+    admission.defer([&deferred]() { deferred++; });
+
+    // 没有设置 executor 时直接执行
+    admission.onMpvEvent(MpvEventEnum::MPV_STOP, 0);
+    CHECK(admission.getState() == State::OPEN);
+    CHECK(downloads.started.size() == 1);
+    CHECK(deferred == 1);
+}
+
+static void testDeferRequest() {
+    NetworkAdmission admission;
+    std::vector<NetworkAdmission::Task> executed;
+    admission.setExecutor(
+        [&executed](NetworkAdmission::Task task) { executed.push_back(task); });
+    admission.onMpvEvent(MpvEventEnum::LOADING_START, 0);
+
+    // 等待期间取消的请求不会发起
+    int started  = 0;
+    auto request  = [&started]() {
+        started++;
+        return bilibili::CancelToken::create();
+    };
+    auto cancelled = admission.deferRequest(request);
+    auto pending   = admission.deferRequest(request);
+    cancelled->cancel();
+    admission.onMpvEvent(MpvEventEnum::LOADING_END, FAST);
+    CHECK(executed.size() == 2);
+    for (auto& task : executed) task();
+    CHECK(started == 1);
+
+    // 发起后取消时一同取消实际的请求
+    CHECK(!pending->isCancelled());
+    auto child = bilibili::CancelToken::create();
+    pending    = admission.deferRequest([child]() { return child; });
+    pending->cancel();
+    CHECK(child->isCancelled());
+}
+
+static void testDisabled() {
+    NetworkAdmission admission;
+    Downloads downloads;
+    NetworkAdmission::ENABLED = false;
+    admission.onMpvEvent(MpvEventEnum::LOADING_START, 0);
+    admission.submit(downloads.make(1));
+    CHECK(downloads.started.size() == 1);
+    NetworkAdmission::ENABLED = true;
+}
+
+int main() {
+    testPauseWhileLoading();
+    testThrottle();
+    testLongPause();
+    testStalledLoading();
+    testStop();
+    testDeferRequest();
+    testDisabled();
+    return 0;
+}
@@ -0,0 +1,135 @@
+// 纹理图集使用的行分配：分配的区域不能越界或重叠，重新排列后能放下更多图片
+
+#include <vector>
+
+#include "test.hpp"
+#include "utils/shelf_packer.hpp"
+
+struct Rect {
+    int x, y, width, height;
+};
+
+/// 所有矩形都在区域内，并且与其他矩形至少间隔 padding
+static bool valid(const std::vector<Rect>& rects, int size, int padding) {
+    for (size_t i = 0; i < rects.size(); i++) {
+        auto& a = rects[i];
+        if (a.x < 0 || a.y < 0 || a.x + a.width > size ||
+            a.y + a.height > size)
+            return false;
+        for (size_t j = i + 1; j < rects.size(); j++) {
+            auto& b = rects[j];
+            if (a.x < b.x + b.width + padding &&
+                b.x < a.x + a.width + padding &&
+                a.y < b.y + b.height + padding &&
+                b.y < a.y + a.height + padding)
+                return false;
+        }
+    }
+    return true;
+}
+
+/// 不同尺寸的图片依次放入，直到空间不足
+static void testAllocate() {
+    ShelfPacker packer(256, 1);
+    std::vector<Rect> rects;
+    int x, y;
+    for (int i = 0;; i++) {
+        int width = 16 + i * 7 % 48, height = 16 + i * 13 % 40;
+        if (!packer.allocate(width, height, x, y)) break;
+        rects.push_back({x, y, width, height});
+    }
+    std::printf("allocate: %zu rects in 256x256\n", rects.size());
+    CHECK(rects.size() > 20);
+    CHECK(valid(rects, 256, 1));
+
+    // 空间不足后较小的图片仍可以放入已有的行
+    CHECK(packer.allocate(4, 4, x, y));
+    rects.push_back({x, y, 4, 4});
+    CHECK(valid(rects, 256, 1));
+
+    // 清空后从左上角开始分配
+    packer.clear();
+    CHECK(packer.allocate(32, 32, x, y));
+    CHECK(x == 0 && y == 0);
+}
+
+/// 尺寸为 0 或超过区域的矩形不分配
+static void testInvalid() {
+    ShelfPacker packer(64, 1);
+    int x, y;
+    CHECK(!packer.allocate(0, 16, x, y));
+    CHECK(!packer.allocate(16, -1, x, y));
+    CHECK(!packer.allocate(65, 16, x, y));
+    CHECK(!packer.allocate(16, 65, x, y));
+    CHECK(packer.allocate(64, 64, x, y));
+    CHECK(!packer.allocate(1, 1, x, y));
+}
+
+/// 高矮交替放入时浪费较多空间，删除一部分后重新排列可以放下更多的图片
+static void testRepack() {
+    const int size = 128;
+    ShelfPacker packer(size, 1);
+    std::vector<ShelfPacker::Position> sizes;
+    int x, y;
+    for (int i = 0;; i++) {
+        int height = i % 2 ? 8 : 30;
+        if (!packer.allocate(30, height, x, y)) break;
+        sizes.push_back({30, height});
+    }
+    size_t before = sizes.size();
+
+    // 删除一半较高的图片
+    std::vector<ShelfPacker::Position> kept;
+    for (size_t i = 0; i < sizes.size(); i++)
+        if (i % 4 != 0) kept.push_back(sizes[i]);
+    auto positions = packer.repack(kept);
+    CHECK(positions.size() == kept.size());
+    std::vector<Rect> rects;
+    for (size_t i = 0; i < kept.size(); i++) {
+        CHECK(positions[i].first >= 0);
+        rects.push_back({positions[i].first, positions[i].second,
+                         kept[i].first, kept[i].second});
+    }
+    CHECK(valid(rects, size, 1));
+
+    // 按高度排列后较高的图片在上方，较矮的图片共用行
+    for (size_t i = 0; i < kept.size(); i++)
+        if (kept[i].second == 8) CHECK(positions[i].second > 0);
+
+    size_t added = 0;
+    while (packer.allocate(30, 8, x, y)) {
+        rects.push_back({x, y, 30, 8});
+        added++;
+    }
+    std::printf("repack: %zu before, %zu kept, %zu added\n", before,
+                kept.size(), added);
+    CHECK(kept.size() + added > before);
+    CHECK(valid(rects, size, 1));
+}
+
+/// 重新排列后放不下的矩形位置为 (-1, -1)，其余矩形的位置与输入顺序对应
+static void testOverflow() {
+    ShelfPacker packer(64, 1);
+    std::vector<ShelfPacker::Position> sizes = {
+        {40, 20}, {64, 64}, {20, 40}, {0, 10}};
+    auto positions = packer.repack(sizes);
+    CHECK(positions.size() == sizes.size());
+    CHECK(positions[1] == ShelfPacker::Position(0, 0));
+    CHECK(positions[0] == ShelfPacker::Position(-1, -1));
+    CHECK(positions[2] == ShelfPacker::Position(-1, -1));
+    CHECK(positions[3] == ShelfPacker::Position(-1, -1));
+
+    sizes.erase(sizes.begin() + 1);
+    positions = packer.repack(sizes);
+    CHECK(positions[0] == ShelfPacker::Position(21, 0));
+    CHECK(positions[1] == ShelfPacker::Position(0, 0));
+    CHECK(positions[2] == ShelfPacker::Position(-1, -1));
+}
+
+int main() {
+    testAllocate();
+    testInvalid();
+    testRepack();
+    testOverflow();
+    return 0;
+}
@@ -11,6 +11,7 @@
 #include "view/recycling_grid.hpp"
 #include "view/auto_tab_frame.hpp"
 #include "utils/singleton.hpp"
+#include "utils/bitrate_selector.hpp"
 #include "view/mpv_core.hpp"
 
 class VideoView;
@@ -48,6 +49,10 @@ public:
     void onVideoRelationInfo(const bilibili::VideoRelation& result) override;
     void onRelatedVideoList(
         const bilibili::VideoDetailListResult& result) override;
+    void onNextVideoPlayUrl(unsigned int cid,
+                            const bilibili::VideoUrlResult& result) override;
+    void onNextVideoDanmaku(unsigned int cid,
+                            const std::vector<DanmakuItem>& items) override;
 
     // 初始化设置 播放界面通用内容
     void setCommonData();
@@ -58,6 +63,25 @@ public:
     // 展示二维码共享对话框
     void showShareDialog(const std::string link);
 
+    // 对候选 CDN 链接测速后播放最快的节点
+    void setMirrorUrl(const std::vector<std::string>& videos, int progress,
+                      const std::vector<std::string>& audios = {});
+
+    // 播放卡顿时切换到下一个节点
+    void switchMirror();
+
+    // 缓冲时间较长时降低码率，过长时切换节点
+    void checkStall();
+
+    // 播放即将结束时预加载下一P或下一集
+    void preloadNext();
+
+    // 根据网速与缓冲自动切换 dash 视频流的码率
+    void updateBitrate();
+
+    // 切换到 dashVideos 中的另一个视频流，从当前进度继续播放
+    void switchBitrate(size_t index);
+
     // 设定当前的播放进度，获取视频链接后会自动跳转到该进度
     virtual void setProgress(int p);
 
@@ -66,6 +90,9 @@ public:
 
     ~PlayerActivity() override;
 
+    /// 剩余播放时间小于此值时预加载下一P或下一集 (秒)
+    inline static int PRELOAD_TIME = 30;
+
 protected:
     BRLS_BIND(VideoView, video, "video/detail/video");
     BRLS_BIND(brls::AppletFrame, appletFrame, "video/detail/frame");
@@ -101,6 +128,49 @@ protected:
 
     // 监控mpv事件
     MPVEvent::Subscription eventSubscribeID;
+
+    // 按速度排序的候选 CDN 链接
+    std::vector<std::string> videoMirrors, audioMirrors;
+    size_t mirrorIndex   = 0;
+    size_t mirrorRequest = 0;
+    // 开始缓冲的时间，用于判断是否需要切换节点
+    bool stalling = false;
+    std::chrono::steady_clock::time_point stallStart;
+    // 当前视频开始播放后的缓冲视为卡顿
+    bool playing       = false;
+    bool stallReported = false;
+
+    // 可以自动切换的 dash 视频流，按码率从低到高排列
+    std::vector<bilibili::DashMedia> dashVideos;
+    size_t dashIndex = 0;
+    BitrateSelector bitrateSelector;
+
+    // 预加载的下一P或下一集
+    struct NextVideo {
+        int index        = -1;     // 在分P或分集列表中的序号
+        unsigned int cid = 0;
+        bool queued      = false;  // 已经加入 mpv 的播放列表
+        bool danmaku     = false;  // 弹幕已经加载
+        bilibili::VideoUrlResult url;
+        std::vector<bilibili::DashMedia> dashVideos;
+        size_t dashIndex = 0;
+        std::vector<std::string> videoMirrors, audioMirrors;
+        std::vector<DanmakuItem> danmakuData;
+    } next;
+    // 切换到下一个视频的开始时间，用于统计切换的间隔
+    bool transitioning = false;
+    std::chrono::steady_clock::time_point transitionStart;
+
+    void playMirror(int progress);
+
+    // 播放列表切换到预加载的视频后，更新当前视频的信息
+    void playNext();
+
+    // 当前分P在分P列表中的序号，没有时返回 -1
+    int getPageIndex();
+
+    // 切换分P后更新播放器标题与分P列表的选中项，手动切换与自动连播共用
+    void onVideoPageInfo();
 };
 
 class PlayerSeasonActivity : public PlayerActivity {
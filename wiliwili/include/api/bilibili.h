@@ -50,299 +50,300 @@ public:
     static Cookies cookies;
 
     /// get qrcode for login
-    static void get_login_url(
+    static CancelHandle get_login_url(
         const std::function<void(std::string, std::string)>& callback = nullptr,
         const ErrorCallback& error = nullptr);
 
     /// check if qrcode has been scanned
-    static void get_login_info(
+    static CancelHandle get_login_info(
         const std::string oauthKey,
         const std::function<void(enum LoginInfo)>& callback = nullptr,
         const ErrorCallback& error                          = nullptr);
 
     /// get person info (if login)
-    static void get_my_info(
+    static CancelHandle get_my_info(
         const std::function<void(UserResult)>& callback = nullptr,
         const ErrorCallback& error                      = nullptr);
 
     /// 获取用户 关注/粉丝/黑名单数量
-    static void get_user_relation(
+    static CancelHandle get_user_relation(
         const std::string& mid,
         const std::function<void(UserRelationStat)>& callback = nullptr,
         const ErrorCallback& error                            = nullptr);
 
     /// 获取用户动态的数量
-    static void get_user_dynamic_count(
+    static CancelHandle get_user_dynamic_count(
         const std::string& mid,
         const std::function<void(UserDynamicCount)>& callback = nullptr,
         const ErrorCallback& error                            = nullptr);
 
     /// get person history videos
-    static void get_my_history(
+    static CancelHandle get_my_history(
         const HistoryVideoListCursor& cursor,
         const std::function<void(HistoryVideoResultWrapper)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// get person collection list
-    static void get_my_collection_list(
+    static CancelHandle get_my_collection_list(
         const int mid, const int index = 1, const int num = 20,
         const std::function<void(CollectionListResultWrapper)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
-    static void get_my_collection_list(
+    static CancelHandle get_my_collection_list(
         const std::string& mid, const int index = 1, const int num = 20,
         const std::function<void(CollectionListResultWrapper)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// get collection video list
-    static void get_collection_video_list(
+    static CancelHandle get_collection_video_list(
         int media_id, const int index = 1, const int num = 20,
         const std::function<void(CollectionVideoListResultWrapper)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// get user's upload videos
-    static void get_user_videos(
+    static CancelHandle get_user_videos(
         int mid, int pn, int ps,
         const std::function<void(UserUploadedVideoResultWrapper)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// get user's dynamic videos
-    static void get_user_videos2(
+    static CancelHandle get_user_videos2(
         int mid, int pn, int ps,
         const std::function<void(UserDynamicVideoResultWrapper)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// get season detail by seasonID
-    static void get_season_detail(
+    static CancelHandle get_season_detail(
         const int seasonID, const int epID = 0,
         const std::function<void(SeasonResultWrapper)>& callback = nullptr,
         const ErrorCallback& error                               = nullptr);
 
     /// get video detail by aid
-    static void get_video_detail(
+    static CancelHandle get_video_detail(
         const int aid,
         const std::function<void(VideoDetailResult)>& callback = nullptr,
         const ErrorCallback& error                             = nullptr);
 
     /// get video detail by bvid
-    static void get_video_detail(
+    static CancelHandle get_video_detail(
         const std::string& bvid,
         const std::function<void(VideoDetailResult)>& callback = nullptr,
         const ErrorCallback& error                             = nullptr);
 
-    static void get_video_detail_all(
+    static CancelHandle get_video_detail_all(
         const std::string& bvid,
         const std::function<void(VideoDetailAllResult)>& callback = nullptr,
         const ErrorCallback& error                                = nullptr);
 
     /// get video pagelist by aid
-    static void get_video_pagelist(
+    static CancelHandle get_video_pagelist(
         const int aid,
         const std::function<void(VideoDetailPageListResult)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// get video pagelist by bvid
-    static void get_video_pagelist(
+    static CancelHandle get_video_pagelist(
         const std::string& bvid,
         const std::function<void(VideoDetailPageListResult)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// get video url by aid & cid
-    static void get_video_url(
+    static CancelHandle get_video_url(
         const int aid, const int cid, const int qn = 64,
         const std::function<void(VideoUrlResult)>& callback = nullptr,
         const ErrorCallback& error                          = nullptr);
 
     /// get video url by bvid & cid
-    static void get_video_url(
+    static CancelHandle get_video_url(
         const std::string& bvid, const int cid, const int qn = 64,
         const std::function<void(VideoUrlResult)>& callback = nullptr,
         const ErrorCallback& error                          = nullptr);
 
     /// get season video url by cid
-    static void get_season_url(
+    static CancelHandle get_season_url(
         const int cid, const int qn = 64,
         const std::function<void(VideoUrlResult)>& callback = nullptr,
         const ErrorCallback& error                          = nullptr);
 
     /// get live video url by roomid
-    static void get_live_url(
+    static CancelHandle get_live_url(
         const int roomid, const int qn = 10000,
         const std::function<void(LiveUrlResultWrapper)>& callback = nullptr,
         const ErrorCallback& error                                = nullptr);
 
     /// 主页 推荐
-    static void get_recommend(
+    static CancelHandle get_recommend(
         const int index = 1, const int num = 24,
         const std::function<void(RecommendVideoListResultWrapper)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// 主页 热门 热门综合
-    static void get_hots_all(
+    static CancelHandle get_hots_all(
         const int index = 1, const int num = 40,
         const std::function<void(HotsAllVideoListResult, bool)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// 主页 热门 每周推荐列表
-    static void get_hots_weekly_list(
+    static CancelHandle get_hots_weekly_list(
         const std::function<void(HotsWeeklyListResult)>& callback = nullptr,
         const ErrorCallback& error                                = nullptr);
 
     /// 主页 热门 每周推荐
-    static void get_hots_weekly(
+    static CancelHandle get_hots_weekly(
         const int number,
         const std::function<void(HotsWeeklyVideoListResult, std::string,
                                  std::string)>& callback = nullptr,
         const ErrorCallback& error                       = nullptr);
 
     /// 主页 热门 入站必刷
-    static void get_hots_history(
+    static CancelHandle get_hots_history(
         const std::function<void(HotsHistoryVideoListResult, std::string)>&
             callback               = nullptr,
         const ErrorCallback& error = nullptr);
 
     /// 主页 热门 排行榜 投稿视频
-    static void get_hots_rank(
+    static CancelHandle get_hots_rank(
         const int rid, const std::string type = "all",
         const std::function<void(HotsRankVideoListResult, std::string)>&
             callback               = nullptr,
         const ErrorCallback& error = nullptr);
 
     /// 主页 热门 排行榜 官方
-    static void get_hots_rank_pgc(
+    static CancelHandle get_hots_rank_pgc(
         const int season_type, const int day = 3,
         const std::function<void(HotsRankPGCVideoListResult, std::string)>&
             callback               = nullptr,
         const ErrorCallback& error = nullptr);
 
     /// 主页 直播推荐
-    static void get_live_recommend(
+    static CancelHandle get_live_recommend(
         int parent_area_id, int area_id, int page,
         const std::string& source                              = "pc",
         const std::function<void(LiveResultWrapper)>& callback = nullptr,
         const ErrorCallback& error                             = nullptr);
 
     /// 主页 追番列表
-    static void get_bangumi(
+    static CancelHandle get_bangumi(
         int is_refresh, const std::string& cursor,
         const std::function<void(PGCResultWrapper)>& callback = nullptr,
         const ErrorCallback& error                            = nullptr);
 
     /// 主页 影视列表
-    static void get_cinema(
+    static CancelHandle get_cinema(
         int is_refresh, const std::string& cursor,
         const std::function<void(PGCResultWrapper)>& callback = nullptr,
         const ErrorCallback& error                            = nullptr);
 
     /// 主页 追番/影视 分类检索
-    static void get_pgc_index(
+    static CancelHandle get_pgc_index(
         const std::string& param, int page = 1,
         const std::function<void(PGCIndexResultWrapper)>& callback = nullptr,
         const ErrorCallback& error                                 = nullptr);
 
     /// 主页 追番/影视 获取分类
-    static void get_pgc_filter(
+    static CancelHandle get_pgc_filter(
         const std::string& index_type,
         const std::function<void(PGCIndexFilterWrapper)>& callback = nullptr,
         const ErrorCallback& error                                 = nullptr);
 
     /// 主页 追番/影视 获取全部分类
-    static void get_pgc_all_filter(
+    static CancelHandle get_pgc_all_filter(
         const std::function<void(PGCIndexFilters)>& callback = nullptr,
         const ErrorCallback& error                           = nullptr);
 
     /// 视频页 获取评论
     /// 3: 热门评论、2：最新评论 1：评论
-    static void get_comment(
+    static CancelHandle get_comment(
         int aid, int next, int mode = 3,
         const std::function<void(VideoCommentResultWrapper)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// 视频页 获取单个视频播放人数
-    static void get_video_online(
+    static CancelHandle get_video_online(
         int aid, int cid,
         const std::function<void(VideoOnlineTotal)>& callback = nullptr,
         const ErrorCallback& error                            = nullptr);
 
-    static void get_video_online(
+    static CancelHandle get_video_online(
         const std::string& bvid, int cid,
         const std::function<void(VideoOnlineTotal)>& callback = nullptr,
         const ErrorCallback& error                            = nullptr);
 
     /// 视频页 获取点赞/收藏/投屏情况
-    static void get_video_relation(
+    static CancelHandle get_video_relation(
         const std::string& bvid,
         const std::function<void(VideoRelation)>& callback = nullptr,
         const ErrorCallback& error                         = nullptr);
 
     /// 视频页 获取弹幕的xml文件
-    static void get_danmaku(
+    static CancelHandle get_danmaku(
         const unsigned int cid,
         const std::function<void(std::string)>& callback = nullptr,
         const ErrorCallback& error                       = nullptr);
 
     /// 视频页 上报历史记录
-    static void report_history(const std::string& mid,
-                               const std::string& access_key, unsigned int aid,
-                               unsigned int cid, int type = 3,
-                               unsigned int progress = 0, unsigned int sid = 0,
-                               unsigned int epid                     = 0,
-                               const std::function<void()>& callback = nullptr,
-                               const ErrorCallback& error            = nullptr);
+    static CancelHandle report_history(
+        const std::string& mid, const std::string& access_key,
+        unsigned int aid, unsigned int cid, int type = 3,
+        unsigned int progress = 0, unsigned int sid = 0, unsigned int epid = 0,
+        const std::function<void()>& callback = nullptr,
+        const ErrorCallback& error            = nullptr);
     /// 点赞
-    static void be_agree(const std::string& access_key, int aid, bool is_like,
-                         const std::function<void()>& callback = nullptr,
-                         const ErrorCallback& error            = nullptr);
+    static CancelHandle be_agree(
+        const std::string& access_key, int aid, bool is_like,
+        const std::function<void()>& callback = nullptr,
+        const ErrorCallback& error            = nullptr);
 
     /// 投币
-    static void add_coin(const std::string& access_key, int aid,
-                         unsigned int coin_number, bool is_like,
-                         const std::function<void()>& callback = nullptr,
-                         const ErrorCallback& error            = nullptr);
+    static CancelHandle add_coin(
+        const std::string& access_key, int aid, unsigned int coin_number,
+        bool is_like, const std::function<void()>& callback = nullptr,
+        const ErrorCallback& error = nullptr);
 
     /// 收藏
-    static void add_resource(const std::string& access_key, int aid,
-                             const std::function<void()>& callback = nullptr,
-                             const ErrorCallback& error            = nullptr);
+    static CancelHandle add_resource(
+        const std::string& access_key, int aid,
+        const std::function<void()>& callback = nullptr,
+        const ErrorCallback& error            = nullptr);
 
     /// 搜索页 获取搜索视频内容
-    static void search_video(
+    static CancelHandle search_video(
         const std::string& key, const std::string& search_type,
         unsigned int index = 1, const std::string& order = "",
         const std::function<void(SearchResult)>& callback = nullptr,
         const ErrorCallback& error                        = nullptr);
     /// 搜索页 获取热搜榜
-    static void get_search_hots(
+    static CancelHandle get_search_hots(
         int limit                                                    = 20,
         const std::function<void(SearchHotsResultWrapper)>& callback = nullptr,
         const ErrorCallback& error                                   = nullptr);
 
     /// 动态页 获取全部关注用户的最近动态
-    static void dynamic_video(
+    static CancelHandle dynamic_video(
         const unsigned int page, const std::string& offset = "",
         const std::function<void(DynamicVideoListResultWrapper)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// 动态页 获取有最近动态的关注用户列表
-    static void dynamic_up_list(
+    static CancelHandle dynamic_up_list(
         const std::function<void(DynamicUpListResultWrapper)>& callback =
             nullptr,
         const ErrorCallback& error = nullptr);
 
     /// 设置页 获取网络时间
-    static void get_unix_time(
+    static CancelHandle get_unix_time(
         const std::function<void(UnixTimeResult)>& callback = nullptr,
         const ErrorCallback& error                          = nullptr);
 
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 namespace bilibili {
 
 namespace Api {
@@ -16,6 +19,19 @@ static const std::string _passBase    = "https://passport.bilibili.com";
 static const std::string _bangumiBase = "https://bangumi.bilibili.com";
 static const std::string _grpcBase    = "https://grpc.biliapi.net";
 
+/// 启动时预先建立连接的域名
+/// 接口返回的封面链接大多是 http 协议
+static const std::vector<std::string> WarmUpHosts = {
+    _apiBase,
+    _appBase,
+    _vcBase,
+    _liveBase,
+    _passBase,
+    "http://i0.hdslb.com",
+    "http://i1.hdslb.com",
+    "http://i2.hdslb.com",
+};
+
 /// ===
 /// 视频API
 /// ===
@@ -36,6 +36,17 @@ inline void from_json(const nlohmann::json& nlohmann_json_j,
     NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, aid, bvid, pic,
                                              title, duration, pubdate, stat));
 }
+inline void json_stream_fields(stream::Fields& f, DynamicVideoResult& t) {
+    f.optional("owner", t.owner);
+    f.fallback("author", t.owner);
+    f.required("aid", t.aid);
+    f.required("bvid", t.bvid);
+    f.required("pic", t.pic);
+    f.required("title", t.title);
+    f.required("duration", t.duration);
+    f.required("pubdate", t.pubdate);
+    f.required("stat", t.stat);
+}
 
 typedef std::vector<DynamicVideoResult> DynamicVideoListResult;
 
@@ -48,9 +59,8 @@ public:
     unsigned int update_num;
     unsigned int page;
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(DynamicVideoListResultWrapper, items,
-                                   has_more, offset, update_baseline,
-                                   update_num);
+BILIBILI_DEFINE_TYPE_STREAM(DynamicVideoListResultWrapper, items, has_more,
+                            offset, update_baseline, update_num);
 
 class DynamicUp {
 public:
@@ -14,7 +14,7 @@ public:
     int view;
     int danmaku;
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(VideoSimpleStateResult, view, danmaku);
+BILIBILI_DEFINE_TYPE_STREAM(VideoSimpleStateResult, view, danmaku);
 
 class RecommendReasonResult {
 public:
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "nlohmann/json.hpp"
+#include "bilibili/util/json_stream.hpp"
 
 namespace bilibili {
 
@@ -15,7 +16,7 @@ public:
     std::string face = "";
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(UserSimpleResult, mid, name, face);
+BILIBILI_DEFINE_TYPE_STREAM(UserSimpleResult, mid, name, face);
 
 class UserSimpleResult2 {
 public:
@@ -24,7 +25,7 @@ public:
     std::string avatar;
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(UserSimpleResult2, mid, uname, avatar);
+BILIBILI_DEFINE_TYPE_STREAM(UserSimpleResult2, mid, uname, avatar);
 
 class UserSimpleResult3 {
 public:
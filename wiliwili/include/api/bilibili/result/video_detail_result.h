@@ -119,6 +119,13 @@ inline void from_json(const nlohmann::json& nlohmann_json_j,
     NLOHMANN_JSON_EXPAND(
         NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, order, length, size, url));
 }
+inline void json_stream_fields(stream::Fields& f, VideoDUrl& t) {
+    f.nullable("backup_url", t.backup_url);
+    f.required("order", t.order);
+    f.required("length", t.length);
+    f.required("size", t.size);
+    f.required("url", t.url);
+}
 
 class DashMedia {
 public:
@@ -129,8 +136,8 @@ public:
     unsigned int bandwidth;
     int width, height;  // only for video
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(DashMedia, id, base_url, backup_url,
-                                   bandwidth, height, width);
+BILIBILI_DEFINE_TYPE_STREAM(DashMedia, id, base_url, backup_url, bandwidth,
+                            height, width);
 
 class Dash {
 public:
@@ -144,6 +151,12 @@ inline void from_json(const nlohmann::json& nlohmann_json_j,
     NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, duration,
                                              video, audio, min_buffer_time));
 }
+inline void json_stream_fields(stream::Fields& f, Dash& t) {
+    f.required("duration", t.duration);
+    f.required("video", t.video);
+    f.required("audio", t.audio);
+    f.required("min_buffer_time", t.min_buffer_time);
+}
 
 class VideoUrlResult {
 public:
@@ -168,6 +181,14 @@ inline void from_json(const nlohmann::json& nlohmann_json_j,
                                              timelength, accept_description,
                                              accept_quality));
 }
+inline void json_stream_fields(stream::Fields& f, VideoUrlResult& t) {
+    f.optional("durl", t.durl);
+    f.optional("dash", t.dash);
+    f.required("quality", t.quality);
+    f.required("timelength", t.timelength);
+    f.required("accept_description", t.accept_description);
+    f.required("accept_quality", t.accept_quality);
+}
 
 // todo：up主精选评论
 
@@ -179,7 +200,7 @@ public:
     //    VideoCommentEmoteMap emote;
     std::string message;
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(VideoCommentContent, message);
+BILIBILI_DEFINE_TYPE_STREAM(VideoCommentContent, message);
 
 class VideoCommentResult {
 public:
@@ -196,6 +217,12 @@ inline void from_json(const nlohmann::json& nlohmann_json_j,
     NLOHMANN_JSON_EXPAND(
         NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, ctime, member, content));
 }
+inline void json_stream_fields(stream::Fields& f, VideoCommentResult& t) {
+    f.nullable("replies", t.replies);
+    f.required("ctime", t.ctime);
+    f.required("member", t.member);
+    f.required("content", t.content);
+}
 
 class VideoCommentCursor {
 public:
@@ -213,6 +240,13 @@ inline void from_json(const nlohmann::json& nlohmann_json_j,
     NLOHMANN_JSON_EXPAND(
         NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, mode, next, is_end, prev));
 }
+inline void json_stream_fields(stream::Fields& f, VideoCommentCursor& t) {
+    f.optional("all_count", t.all_count);
+    f.required("mode", t.mode);
+    f.required("next", t.next);
+    f.required("is_end", t.is_end);
+    f.required("prev", t.prev);
+}
 
 typedef std::vector<VideoCommentResult> VideoCommentListResult;
 
@@ -232,6 +266,12 @@ inline void from_json(const nlohmann::json& nlohmann_json_j,
     }
     NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, cursor));
 }
+inline void json_stream_fields(stream::Fields& f,
+                               VideoCommentResultWrapper& t) {
+    f.nullable("top_replies", t.top_replies);
+    f.nullable("replies", t.replies);
+    f.required("cursor", t.cursor);
+}
 
 class VideoRelation {
 public:
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace bilibili {
+
+class CancelToken;
+using CancelHandle = std::shared_ptr<CancelToken>;
+
+/// 请求的取消标记
+/// 取消后正在进行的传输会在下一次进度回调时中断，且不再解析数据与回调
+class CancelToken : public std::enable_shared_from_this<CancelToken> {
+public:
+    static CancelHandle create() { return std::make_shared<CancelToken>(); }
+
+    void cancel() {
+        std::vector<std::function<void()>> callbacks;
+        {
+            std::unique_lock<std::mutex> lock(tokenMutex);
+            if (cancelled || finished) return;
+            cancelled = true;
+            callbacks.swap(listeners);
+        }
+        CANCELLED_REQUESTS++;
+        for (auto& callback : callbacks) callback();
+    }
+
+    bool isCancelled() const { return cancelled; }
+
+    /// 请求结束，在执行回调前调用，之后不能再取消
+    /// 已经取消时返回 false，此时不应执行回调
+    /// 取消与结束只会发生一个，取消时的回调与请求的回调不会都执行
+    bool finish() {
+        std::unique_lock<std::mutex> lock(tokenMutex);
+        if (cancelled) return false;
+        auto owner = parent.lock();
+        if (owner && !owner->finish()) return false;
+        finished = true;
+        listeners.clear();
+        return true;
+    }
+
+    bool isFinished() const { return finished; }
+
+    /// 取消时执行，已经取消时立即执行
+    void onCancel(const std::function<void()>& callback) {
+        {
+            std::unique_lock<std::mutex> lock(tokenMutex);
+            if (finished) return;
+            if (!cancelled) {
+                listeners.push_back(callback);
+                return;
+            }
+        }
+        callback();
+    }
+
+    /// 由多个请求组成的请求，取消时一同取消
+    void link(const CancelHandle& child) {
+        if (child) onCancel([child]() { child->cancel(); });
+    }
+
+    /// 延迟发起的请求，由 child 完成实际的传输
+    /// 取消时一同取消，child 结束时此请求也结束
+    void delegate(const CancelHandle& child) {
+        if (!child) {
+            finish();
+            return;
+        }
+        bool done;
+        {
+            std::unique_lock<std::mutex> lock(child->tokenMutex);
+            child->parent = shared_from_this();
+            done          = child->finished;
+        }
+        // child 在关联之前已经结束
+        if (done)
+            finish();
+        else
+            link(child);
+    }
+
+    /// 被取消的请求数量
+    inline static std::atomic<size_t> CANCELLED_REQUESTS{0};
+
+    /// 因取消而没有下载的数据量 (bytes)
+    inline static std::atomic<size_t> CANCELLED_BYTES{0};
+
+private:
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> finished{false};
+    std::vector<std::function<void()>> listeners;
+    std::weak_ptr<CancelToken> parent;
+    std::mutex tokenMutex;
+};
+
+/// 保存一组请求，析构时取消其中未结束的请求
+class CancelGroup {
+public:
+    ~CancelGroup() { cancel(); }
+
+    void add(const CancelHandle& handle) {
+        if (!handle) return;
+        std::unique_lock<std::mutex> lock(groupMutex);
+        // 移除已经结束的请求
+        handles.erase(std::remove_if(handles.begin(), handles.end(),
+                                     [](const CancelHandle& i) {
+                                         return i->isFinished() ||
+                                                i->isCancelled();
+                                     }),
+                      handles.end());
+        handles.push_back(handle);
+    }
+
+    void cancel() {
+        std::vector<CancelHandle> requests;
+        {
+            std::unique_lock<std::mutex> lock(groupMutex);
+            requests.swap(handles);
+        }
+        for (auto& i : requests) i->cancel();
+    }
+
+private:
+    std::vector<CancelHandle> handles;
+    std::mutex groupMutex;
+};
+
+}  // namespace bilibili
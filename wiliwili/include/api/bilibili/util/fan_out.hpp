@@ -0,0 +1,98 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "bilibili/util/cancel_token.hpp"
+
+namespace bilibili {
+
+/// 同时发起多个相互独立的请求，将结果汇总到 Aggregate 中
+/// 全部请求成功后回调一次汇总结果
+/// 任意一个请求失败时立即回调错误并取消其他请求，之后的结果会被忽略
+///
+/// auto join = FanOut<Result>::create(n, callback, error);
+/// 发起请求后调用 join->add(handle)
+/// 每个请求成功时调用 join->resolve([](Result& res){...})
+/// 失败时调用 join->reject(msg)
+template <typename Aggregate>
+class FanOut {
+public:
+    using Callback      = std::function<void(Aggregate)>;
+    using ErrorCallback = std::function<void(const std::string&)>;
+
+    static std::shared_ptr<FanOut> create(size_t count, Callback callback,
+                                          ErrorCallback error = nullptr) {
+        auto join = std::shared_ptr<FanOut>(
+            new FanOut(count, std::move(callback), std::move(error)));
+        if (count == 0) join->finish();
+        return join;
+    }
+
+    /// 加入一个请求，已经有请求失败时立即取消
+    void add(const CancelHandle& handle) {
+        if (!handle) return;
+        {
+            std::unique_lock<std::mutex> lock(joinMutex);
+            if (!finished) {
+                handles.push_back(handle);
+                return;
+            }
+            if (!rejected) return;
+        }
+        handle->cancel();
+    }
+
+    /// 一个请求成功，在 merge 中将结果写入汇总数据
+    void resolve(const std::function<void(Aggregate&)>& merge) {
+        {
+            std::unique_lock<std::mutex> lock(joinMutex);
+            if (finished) return;
+            if (merge) merge(result);
+            if (--remaining > 0) return;
+            finished = true;
+            handles.clear();
+        }
+        if (callback) callback(std::move(result));
+    }
+
+    /// 一个请求失败，只有第一个错误会被回调，其他未结束的请求会被取消
+    void reject(const std::string& msg) {
+        std::vector<CancelHandle> requests;
+        {
+            std::unique_lock<std::mutex> lock(joinMutex);
+            if (finished) return;
+            finished = true;
+            rejected = true;
+            requests.swap(handles);
+        }
+        for (auto& i : requests)
+            if (!i->isFinished()) i->cancel();
+        if (error) error(msg);
+    }
+
+private:
+    FanOut(size_t count, Callback callback, ErrorCallback error)
+        : remaining(count),
+          callback(std::move(callback)),
+          error(std::move(error)) {}
+
+    void finish() {
+        finished = true;
+        if (callback) callback(std::move(result));
+    }
+
+    std::mutex joinMutex;
+    Aggregate result;
+    size_t remaining;
+    bool finished = false;
+    bool rejected = false;
+    std::vector<CancelHandle> handles;
+    Callback callback;
+    ErrorCallback error;
+};
+
+}  // namespace bilibili
@@ -6,8 +6,14 @@
 
 #include <nlohmann/json.hpp>
 #include <cpr/cpr.h>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 
+#include "bilibili/util/cancel_token.hpp"
+#include "bilibili/util/json_stream.hpp"
 #include "bilibili/util/md5.hpp"
+#include "bilibili/util/response_cache.hpp"
 #include "utils/number_helper.hpp"
 #include "pystring.h"
 
@@ -29,6 +35,14 @@ public:
     static cpr::Header HEADERS;
     static int TIMEOUT;
 
+    /// getResultAsync 收到的请求总数
+    inline static std::atomic<size_t> REQUEST_TOTAL{0};
+    /// 与进行中的请求合并，没有实际发出的请求数
+    inline static std::atomic<size_t> REQUEST_COALESCED{0};
+
+    /// 是否使用流式解析
+    inline static bool STREAM_PARSE = true;
+
     static cpr::Response get(const std::string& url,
                              const cpr::Parameters& parameters = {},
                              int timeout                       = 10000);
@@ -62,39 +76,102 @@ public:
         }
     }
 
-    static void __cpr_post(
+    /// 使用连接池中的 Session 发送异步 GET 请求
+    /// handle 被取消后中断传输，不再执行回调
+    static CancelHandle __cpr_get(
+        const std::string& url, cpr::Parameters parameters = {},
+        const std::function<void(const cpr::Response&)>& callback = nullptr,
+        const cpr::Header& header = {}, CancelHandle handle = nullptr);
+
+    /// 使用连接池中的 Session 发送异步 POST 请求
+    static CancelHandle __cpr_post(
         const std::string& url, cpr::Parameters parameters = {},
         cpr::Payload payload                                      = {},
         const std::function<void(const cpr::Response&)>& callback = nullptr,
-        const ErrorCallback& error                                = nullptr) {
-        cpr::PostCallback(
-            [callback, error](cpr::Response r) {
-                if (r.status_code != 200) {
-                    ERROR_MSG("Network error. [Status code: " +
-                                  std::to_string(r.status_code) + " ]",
-                              -404);
-                    return;
+        const ErrorCallback& error                                = nullptr);
+
+    /// 解析接口返回的数据，成功时返回 true
+    template <typename ReturnType>
+    static bool parseResult(const cpr::Response& r,
+                            const std::function<void(ReturnType)>& callback,
+                            const ErrorCallback& error) {
+        try {
+            // 支持流式解析的类型直接从文本解析，失败时再用 json 解析获取错误信息
+            if constexpr (stream::is_streamable<ReturnType>::value) {
+                if (STREAM_PARSE) {
+                    ReturnType data;
+                    if (stream::parseResponse(r.text, data)) {
+                        if (callback) callback(std::move(data));
+                        return true;
+                    }
                 }
-                callback(r);
-            },
-            cpr::Url{url},
-            cpr::Header{
-                {"User-Agent", "NintendoSwitch"},
-                {"Referer", "https://www.bilibili.com/"},
-                {"Origin", "https://www.bilibili.com"},
-            },
-            parameters, payload, HTTP::COOKIES,
-#ifndef VERIFY_SSL
-            cpr::VerifySsl{false},
-#endif
-            cpr::Timeout{HTTP::TIMEOUT});
+            }
+            nlohmann::json res = nlohmann::json::parse(r.text);
+            int code           = res.at("code");
+            if (code == 0) {
+                if (res.contains("data")) {
+                    if (callback) callback(res.at("data").get<ReturnType>());
+                } else if (res.contains("result")) {
+                    if (callback) callback(res.at("result").get<ReturnType>());
+                } else {
+                    printf("data: %s\n", r.text.c_str());
+                    ERROR_MSG("Cannot find data");
+                    return false;
+                }
+                return true;
+            } else {
+                if (error) {
+                    if (res.at("message").is_string()) {
+                        ERROR_MSG("error msg: " +
+                                  res.at("message").get<std::string>() +
+                                  "; error code: " + std::to_string(code));
+                    } else {
+                        ERROR_MSG("Param error");
+                    }
+                }
+            }
+        } catch (const std::exception& e) {
+            ERROR_MSG("Network error. [Status code: " +
+                          std::to_string(r.status_code) + " ]",
+                      -404);
+            printf("data: %s\n", r.text.c_str());
+            printf("ERROR: %s\n", e.what());
+        }
+        return false;
     }
 
+    /// 相同的请求同时只会发送一次，所有的回调共用同一个请求的结果
+    /// 所有的回调都被取消后才会中断请求
     template <typename ReturnType>
-    static void getResultAsync(
+    static CancelHandle getResultAsync(
         const std::string& url, cpr::Parameters parameters = {},
         const std::function<void(ReturnType)>& callback = nullptr,
         const ErrorCallback& error = nullptr, bool needSign = false) {
+        // 签名中包含时间戳，所以在签名前计算 key
+        std::string key     = ResponseCache::getKey(url, parameters);
+        auto& group         = InFlightRequests<ReturnType>::instance();
+        CancelHandle handle = CancelToken::create();
+        CancelHandle transfer;
+        bool coalesced = false;
+        REQUEST_TOTAL++;
+        {
+            std::unique_lock<std::mutex> lock(group.mutex);
+            auto& request = group.requests[key];
+            if (request.transfer && !request.transfer->isCancelled()) {
+                coalesced = true;
+                REQUEST_COALESCED++;
+            } else {
+                request.transfer = CancelToken::create();
+                request.waiters.clear();
+            }
+            request.waiters.push_back({callback, error, handle});
+            transfer = request.transfer;
+        }
+        handle->onCancel([key, transfer]() {
+            InFlightRequests<ReturnType>::instance().cancel(key, transfer);
+        });
+        if (coalesced) return handle;
+
         if (needSign) {
             parameters.Add(
                 {{"appkey", BILIBILI_APP_KEY},
@@ -107,58 +184,92 @@ public:
                 {{"sign", websocketpp::md5::md5_hash_hex(
                               pystring::join("&", kv) + BILIBILI_APP_SECRET)}});
         }
-        cpr::GetCallback(
-            [callback, error](cpr::Response r) {
-                try {
-                    nlohmann::json res = nlohmann::json::parse(r.text);
-                    int code           = res.at("code");
-                    if (code == 0) {
-                        if (res.contains("data")) {
-                            if (callback)
-                                callback(res.at("data").get<ReturnType>());
-                        } else if (res.contains("result")) {
-                            if (callback)
-                                callback(res.at("result").get<ReturnType>());
-                        } else {
-                            printf("data: %s\n", r.text.c_str());
-                            ERROR_MSG("Cannot find data");
-                        }
+        __cpr_get(
+            url, parameters,
+            [key, transfer](const cpr::Response& r) {
+                auto& requests = InFlightRequests<ReturnType>::instance();
+                auto waiters   = requests.take(key, transfer);
+                if (waiters.empty()) return;
+                parseResult<ReturnType>(
+                    r,
+                    [&waiters](ReturnType data) {
+                        for (auto& i : waiters)
+                            if (i.handle->finish() && i.callback)
+                                i.callback(data);
+                    },
+                    [&waiters](const std::string& msg) {
+                        for (auto& i : waiters)
+                            if (i.handle->finish() && i.error) i.error(msg);
+                    });
+            },
+            {}, transfer);
+        return handle;
+    }
+
+    /// 优先使用缓存的数据，缓存超过 ttl (秒) 后在后台重新请求并更新缓存
+    /// 离线时会一直使用缓存的数据
+    template <typename ReturnType>
+    static CancelHandle getResultCachedAsync(
+        const std::string& url, cpr::Parameters parameters = {},
+        time_t ttl                                      = 3600,
+        const std::function<void(ReturnType)>& callback = nullptr,
+        const ErrorCallback& error                      = nullptr) {
+        std::string key     = ResponseCache::getKey(url, parameters);
+        CancelHandle handle = CancelToken::create();
+        cpr::async([url, parameters, ttl, key, callback, error, handle]() {
+            if (handle->isCancelled()) return;
+            ResponseCache::Entry entry;
+            bool delivered = false;
+            if (ResponseCache::instance().get(key, entry)) {
+                cpr::Response cache;
+                cache.status_code = 200;
+                cache.text        = entry.body;
+                delivered = parseResult<ReturnType>(
+                    cache,
+                    [handle, &callback](ReturnType data) {
+                        if (handle->finish() && callback)
+                            callback(std::move(data));
+                    },
+                    nullptr);
+                if (delivered && !entry.expired(ttl)) return;
+            }
+
+            cpr::Header header;
+            if (delivered) {
+                if (!entry.etag.empty()) header["If-None-Match"] = entry.etag;
+                if (!entry.lastModified.empty())
+                    header["If-Modified-Since"] = entry.lastModified;
+            }
+            __cpr_get(
+                url, parameters,
+                [key, delivered, callback, error](const cpr::Response& r) {
+                    if (delivered && r.status_code == 304) {
+                        ResponseCache::instance().touch(key);
                         return;
-                    } else {
-                        if (error) {
-                            if (res.at("message").is_string()) {
-                                ERROR_MSG(
-                                    "error msg: " +
-                                    res.at("message").get<std::string>() +
-                                    "; error code: " + std::to_string(code));
-                            } else {
-                                ERROR_MSG("Param error");
-                            }
-                        }
                     }
-                } catch (const std::exception& e) {
-                    ERROR_MSG("Network error. [Status code: " +
-                                  std::to_string(r.status_code) + " ]",
-                              -404);
-                    printf("data: %s\n", r.text.c_str());
-                    printf("ERROR: %s\n", e.what());
-                }
-            },
-            cpr::Url{url},
-            cpr::Header{
-                {"User-Agent", "NintendoSwitch"},
-                {"Referer", "https://www.bilibili.com/"},
-                {"Origin", "https://www.bilibili.com"},
-            },
-            parameters, HTTP::COOKIES,
-#ifndef VERIFY_SSL
-            cpr::VerifySsl{false},
-#endif
-            cpr::Timeout{HTTP::TIMEOUT});
+                    // 已经使用缓存的数据回调过，这里只更新缓存
+                    if (!parseResult<ReturnType>(
+                            r, delivered ? nullptr : callback,
+                            delivered ? nullptr : error))
+                        return;
+                    ResponseCache::Entry entry;
+                    entry.body = r.text;
+                    entry.time = std::time(nullptr);
+                    auto etag  = r.header.find("ETag");
+                    if (etag != r.header.end()) entry.etag = etag->second;
+                    auto lastModified = r.header.find("Last-Modified");
+                    if (lastModified != r.header.end())
+                        entry.lastModified = lastModified->second;
+                    ResponseCache::instance().put(key, entry);
+                },
+                // 已经回调过的请求只用于更新缓存，不需要随组件取消
+                header, delivered ? nullptr : handle);
+        });
+        return handle;
     }
 
     template <typename ReturnType>
-    static void postResultAsync(
+    static CancelHandle postResultAsync(
         const std::string& url, cpr::Parameters parameters = {},
         cpr::Payload payload                            = {},
         const std::function<void(ReturnType)>& callback = nullptr,
@@ -175,7 +286,7 @@ public:
                 {{"sign", websocketpp::md5::md5_hash_hex(
                               pystring::join("&", kv) + BILIBILI_APP_SECRET)}});
         }
-        __cpr_post(
+        return __cpr_post(
             url, parameters, payload,
             [callback, error](const cpr::Response& r) {
                 try {
@@ -197,6 +308,56 @@ public:
             },
             error);
     }
+
+private:
+    /// 进行中的请求与等待结果的回调
+    template <typename ReturnType>
+    struct InFlightRequests {
+        struct Waiter {
+            std::function<void(ReturnType)> callback;
+            ErrorCallback error;
+            CancelHandle handle;
+        };
+
+        struct Request {
+            CancelHandle transfer;
+            std::vector<Waiter> waiters;
+        };
+
+        std::mutex mutex;
+        std::unordered_map<std::string, Request> requests;
+
+        static InFlightRequests& instance() {
+            static InFlightRequests requests;
+            return requests;
+        }
+
+        /// 请求结束，取出等待结果的回调
+        std::vector<Waiter> take(const std::string& key,
+                                 const CancelHandle& transfer) {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto it = requests.find(key);
+            if (it == requests.end() || it->second.transfer != transfer)
+                return {};
+            auto waiters = std::move(it->second.waiters);
+            requests.erase(it);
+            return waiters;
+        }
+
+        /// 所有的回调都被取消后中断请求
+        void cancel(const std::string& key, const CancelHandle& transfer) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                auto it = requests.find(key);
+                if (it == requests.end() || it->second.transfer != transfer)
+                    return;
+                for (auto& i : it->second.waiters)
+                    if (!i.handle->isCancelled()) return;
+                requests.erase(it);
+            }
+            transfer->cancel();
+        }
+    };
 };
 
 }  // namespace bilibili
\ No newline at end of file
@@ -0,0 +1,466 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// 在 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE 的基础上额外生成流式解析所需的字段列表
+/// 使用此宏定义的类型可以直接从文本中解析，不需要先构建完整的 json 对象
+#define BILIBILI_DEFINE_TYPE_STREAM(Type, ...)                              \
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Type, __VA_ARGS__)                   \
+    inline void json_stream_fields(bilibili::stream::Fields& fields,        \
+                                   Type& nlohmann_json_t) {                 \
+        NLOHMANN_JSON_EXPAND(                                               \
+            NLOHMANN_JSON_PASTE(BILIBILI_STREAM_REQUIRED, __VA_ARGS__))     \
+    }
+
+#define BILIBILI_STREAM_REQUIRED(v1) \
+    fields.required(#v1, nlohmann_json_t.v1);
+
+namespace bilibili::stream {
+
+/// 接收 json 中一个值的解析事件，类型不匹配时返回 false
+class Sink {
+public:
+    virtual ~Sink() = default;
+
+    virtual bool null() { return false; }
+    virtual bool boolean(bool) { return false; }
+    virtual bool integer(int64_t) { return false; }
+    virtual bool unsignedInteger(uint64_t) { return false; }
+    virtual bool floating(double) { return false; }
+    virtual bool string(std::string&) { return false; }
+
+    virtual bool startObject() { return false; }
+    virtual bool startArray() { return false; }
+    /// 对象中的下一个 key，返回接收对应值的 Sink，返回空指针时解析失败
+    virtual Sink* key(const std::string&) { return nullptr; }
+    /// 数组中的下一个元素
+    virtual Sink* element() { return nullptr; }
+    /// 对象或数组结束
+    virtual bool end() { return true; }
+};
+
+template <typename T>
+std::unique_ptr<Sink> makeSink(T& value);
+
+template <typename T>
+std::unique_ptr<Sink> makeSink(std::vector<T>& value);
+
+/// 忽略不需要的字段
+class SkipSink : public Sink {
+public:
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool integer(int64_t) override { return true; }
+    bool unsignedInteger(uint64_t) override { return true; }
+    bool floating(double) override { return true; }
+    bool string(std::string&) override { return true; }
+    bool startObject() override { return true; }
+    bool startArray() override { return true; }
+    Sink* key(const std::string&) override { return this; }
+    Sink* element() override { return this; }
+
+    static SkipSink* instance() {
+        static SkipSink sink;
+        return &sink;
+    }
+};
+
+/// 数字，与 nlohmann::json 相同，允许数字与布尔值之间的转换
+template <typename T>
+class NumberSink : public Sink {
+public:
+    explicit NumberSink(T& value) : value(value) {}
+    bool boolean(bool v) override { return set(v); }
+    bool integer(int64_t v) override { return set(v); }
+    bool unsignedInteger(uint64_t v) override { return set(v); }
+    bool floating(double v) override { return set(v); }
+
+private:
+    T& value;
+
+    template <typename V>
+    bool set(V v) {
+        value = static_cast<T>(v);
+        return true;
+    }
+};
+
+class BoolSink : public Sink {
+public:
+    explicit BoolSink(bool& value) : value(value) {}
+    bool boolean(bool v) override {
+        value = v;
+        return true;
+    }
+
+private:
+    bool& value;
+};
+
+class StringSink : public Sink {
+public:
+    explicit StringSink(std::string& value) : value(value) {}
+    bool string(std::string& v) override {
+        value = std::move(v);
+        return true;
+    }
+
+private:
+    std::string& value;
+};
+
+template <typename T>
+class VectorSink : public Sink {
+public:
+    explicit VectorSink(std::vector<T>& value) : value(value) {}
+    bool startArray() override {
+        value.clear();
+        return true;
+    }
+    Sink* element() override {
+        value.emplace_back();
+        child = makeSink(value.back());
+        return child.get();
+    }
+
+private:
+    std::vector<T>& value;
+    std::unique_ptr<Sink> child;
+};
+
+/// 值为 null 时保留默认值
+class NullableSink : public Sink {
+public:
+    explicit NullableSink(std::unique_ptr<Sink> sink) : sink(std::move(sink)) {}
+
+    bool null() override { return true; }
+    bool boolean(bool v) override { return sink->boolean(v); }
+    bool integer(int64_t v) override { return sink->integer(v); }
+    bool unsignedInteger(uint64_t v) override {
+        return sink->unsignedInteger(v);
+    }
+    bool floating(double v) override { return sink->floating(v); }
+    bool string(std::string& v) override { return sink->string(v); }
+    bool startObject() override { return sink->startObject(); }
+    bool startArray() override { return sink->startArray(); }
+    Sink* key(const std::string& k) override { return sink->key(k); }
+    Sink* element() override { return sink->element(); }
+    bool end() override { return sink->end(); }
+
+private:
+    std::unique_ptr<Sink> sink;
+};
+
+/// 没有提供字段列表的类型先构建 json 对象，再使用原有的 from_json 转换
+template <typename T>
+class DomSink : public Sink {
+public:
+    explicit DomSink(T& value) : value(value) {}
+
+    bool null() override { return put(nullptr); }
+    bool boolean(bool v) override { return put(v); }
+    bool integer(int64_t v) override { return put(v); }
+    bool unsignedInteger(uint64_t v) override { return put(v); }
+    bool floating(double v) override { return put(v); }
+    bool string(std::string& v) override { return put(std::move(v)); }
+
+    bool startObject() override {
+        auto* current = slot();
+        *current      = nlohmann::json::object();
+        stack.push_back(current);
+        return true;
+    }
+    bool startArray() override {
+        auto* current = slot();
+        *current      = nlohmann::json::array();
+        stack.push_back(current);
+        return true;
+    }
+    Sink* key(const std::string& k) override {
+        pendingKey = k;
+        return this;
+    }
+    Sink* element() override { return this; }
+    bool end() override {
+        stack.pop_back();
+        return stack.empty() ? convert() : true;
+    }
+
+private:
+    T& value;
+    nlohmann::json root;
+    std::vector<nlohmann::json*> stack;
+    std::string pendingKey;
+
+    nlohmann::json* slot() {
+        if (stack.empty()) return &root;
+        auto* top = stack.back();
+        if (top->is_object()) return &(*top)[pendingKey];
+        top->push_back(nullptr);
+        return &top->back();
+    }
+
+    bool put(nlohmann::json v) {
+        *slot() = std::move(v);
+        return stack.empty() ? convert() : true;
+    }
+
+    bool convert() {
+        try {
+            root.get_to(value);
+        } catch (const std::exception&) {
+            return false;
+        }
+        return true;
+    }
+};
+
+/// 遍历类型的字段列表
+/// 查找 key 对应的字段，或检查必须存在的字段是否都已经解析
+class Fields {
+public:
+    /// key 为空时检查必须存在的字段，seen 中记录了已经解析的字段序号
+    Fields(const std::string* key, uint64_t seen) : key(key), seen(seen) {}
+
+    /// 字段必须存在且不为 null，对应 NLOHMANN_JSON_FROM
+    template <typename T>
+    void required(const char* name, T& value) {
+        visit(name, value, false, true);
+    }
+
+    /// 字段必须存在，为 null 时保留默认值
+    template <typename T>
+    void nullable(const char* name, T& value) {
+        visit(name, value, true, true);
+    }
+
+    /// 字段可以不存在或为 null
+    template <typename T>
+    void optional(const char* name, T& value) {
+        visit(name, value, true, false);
+    }
+
+    /// 作为前一个字段的备选，字段可以不存在或为 null
+    /// 与 from_json 中 contains 的判断顺序相同，前一个字段已经解析时忽略此字段
+    template <typename T>
+    void fallback(const char* name, T& value) {
+        size_t previous = index - 1;
+        if (key && index > 0 && previous < 64 && (seen & (1ULL << previous))) {
+            index++;
+            return;
+        }
+        visit(name, value, true, false);
+    }
+
+    /// key 对应字段的序号与 Sink
+    size_t found = SIZE_MAX;
+    std::unique_ptr<Sink> sink;
+    /// 是否缺少必须存在的字段
+    bool missing = false;
+
+private:
+    const std::string* key;
+    uint64_t seen;
+    size_t index = 0;
+
+    template <typename T>
+    void visit(const char* name, T& value, bool allowNull, bool isRequired) {
+        size_t i = index++;
+        if (key) {
+            if (sink || *key != name) return;
+            found = i;
+            if (allowNull)
+                sink = std::make_unique<NullableSink>(makeSink(value));
+            else
+                sink = makeSink(value);
+        } else if (isRequired && i < 64 && !(seen & (1ULL << i))) {
+            missing = true;
+        }
+    }
+};
+
+/// 判断类型是否提供了 json_stream_fields
+template <typename T, typename = void>
+struct is_streamable : std::false_type {};
+
+template <typename T>
+struct is_streamable<T, std::void_t<decltype(json_stream_fields(
+                            std::declval<Fields&>(), std::declval<T&>()))>>
+    : std::true_type {};
+
+template <typename T>
+class ObjectSink : public Sink {
+public:
+    explicit ObjectSink(T& value) : value(value) {}
+
+    bool startObject() override { return true; }
+
+    Sink* key(const std::string& k) override {
+        Fields fields(&k, seen);
+        json_stream_fields(fields, value);
+        if (!fields.sink) return SkipSink::instance();
+        if (fields.found < 64) seen |= 1ULL << fields.found;
+        child = std::move(fields.sink);
+        return child.get();
+    }
+
+    bool end() override {
+        Fields fields(nullptr, seen);
+        json_stream_fields(fields, value);
+        return !fields.missing;
+    }
+
+private:
+    T& value;
+    uint64_t seen = 0;
+    std::unique_ptr<Sink> child;
+};
+
+template <typename T>
+std::unique_ptr<Sink> makeSink(T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        return std::make_unique<BoolSink>(value);
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        return std::make_unique<NumberSink<T>>(value);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return std::make_unique<StringSink>(value);
+    } else if constexpr (is_streamable<T>::value) {
+        return std::make_unique<ObjectSink<T>>(value);
+    } else {
+        return std::make_unique<DomSink<T>>(value);
+    }
+}
+
+template <typename T>
+std::unique_ptr<Sink> makeSink(std::vector<T>& value) {
+    return std::make_unique<VectorSink<T>>(value);
+}
+
+/// 接口返回的外层数据: {"code": 0, "message": "", "data": {...}}
+/// data 或 result 中的内容直接解析到 ReturnType
+template <typename ReturnType>
+class ResponseSink : public Sink {
+public:
+    explicit ResponseSink(ReturnType& value) : value(value) {}
+
+    int code       = -1;
+    bool hasResult = false;
+
+    bool startObject() override { return true; }
+
+    Sink* key(const std::string& k) override {
+        if (k == "code") {
+            child = makeSink(code);
+        } else if (k == "data" || k == "result") {
+            // 与 HTTP::parseResult 相同，优先使用 data
+            if (hasResult) {
+                if (k == "result") return SkipSink::instance();
+                return nullptr;
+            }
+            hasResult = true;
+            child     = makeSink(value);
+        } else {
+            return SkipSink::instance();
+        }
+        return child.get();
+    }
+
+private:
+    ReturnType& value;
+    std::unique_ptr<Sink> child;
+};
+
+/// nlohmann::json 的 SAX 接口，将解析事件分发给对应的 Sink
+class SaxDriver : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit SaxDriver(Sink* root) : root(root) {}
+
+    bool null() override {
+        auto* t = target();
+        return t && t->null();
+    }
+    bool boolean(bool val) override {
+        auto* t = target();
+        return t && t->boolean(val);
+    }
+    bool number_integer(number_integer_t val) override {
+        auto* t = target();
+        return t && t->integer(val);
+    }
+    bool number_unsigned(number_unsigned_t val) override {
+        auto* t = target();
+        return t && t->unsignedInteger(val);
+    }
+    bool number_float(number_float_t val, const string_t&) override {
+        auto* t = target();
+        return t && t->floating(val);
+    }
+    bool string(string_t& val) override {
+        auto* t = target();
+        return t && t->string(val);
+    }
+    bool binary(binary_t&) override { return false; }
+
+    bool start_object(std::size_t) override {
+        auto* t = target();
+        if (!t || !t->startObject()) return false;
+        stack.push_back({t, false});
+        return true;
+    }
+    bool key(string_t& val) override {
+        pending = stack.back().sink->key(val);
+        return pending != nullptr;
+    }
+    bool end_object() override { return pop(); }
+
+    bool start_array(std::size_t) override {
+        auto* t = target();
+        if (!t || !t->startArray()) return false;
+        stack.push_back({t, true});
+        return true;
+    }
+    bool end_array() override { return pop(); }
+
+    bool parse_error(std::size_t, const std::string&,
+                     const nlohmann::detail::exception&) override {
+        return false;
+    }
+
+private:
+    struct Frame {
+        Sink* sink;
+        bool array;
+    };
+
+    Sink* root;
+    Sink* pending = nullptr;
+    std::vector<Frame> stack;
+
+    Sink* target() {
+        if (stack.empty()) return root;
+        if (stack.back().array) return stack.back().sink->element();
+        return pending;
+    }
+
+    bool pop() {
+        auto* sink = stack.back().sink;
+        stack.pop_back();
+        return sink->end();
+    }
+};
+
+/// 流式解析接口返回的数据，code 不为 0、数据不完整或类型不匹配时返回 false
+template <typename ReturnType>
+bool parseResponse(const std::string& text, ReturnType& value) {
+    ResponseSink<ReturnType> sink(value);
+    SaxDriver driver(&sink);
+    bool res = nlohmann::json::sax_parse(text, &driver);
+    return res && sink.code == 0 && sink.hasResult;
+}
+
+}  // namespace bilibili::stream
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cpr/cpr.h>
+#include <ctime>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "utils/singleton.hpp"
+
+namespace bilibili {
+
+/// 接口返回数据的磁盘缓存
+/// 用于分类、排行榜等变化较慢的接口，冷启动或离线时可以直接使用缓存的数据
+class ResponseCache : public Singleton<ResponseCache> {
+public:
+    struct Entry {
+        std::string body;
+        std::string etag;
+        std::string lastModified;
+        time_t time = 0;
+
+        /// 缓存时间是否超过 ttl (秒)
+        bool expired(time_t ttl) const;
+    };
+
+    /// 根据 url 与排序后的参数生成缓存的 key
+    static std::string getKey(const std::string& url,
+                              const cpr::Parameters& parameters);
+
+    /// 读取缓存，内存中没有时从磁盘读取
+    bool get(const std::string& key, Entry& entry);
+
+    /// 写入缓存，同时保存到磁盘
+    void put(const std::string& key, const Entry& entry);
+
+    /// 服务器返回 304 时只更新缓存时间
+    void touch(const std::string& key);
+
+    /// 删除所有缓存
+    void clear();
+
+    /// 缓存目录，为空时只在内存中缓存
+    inline static std::string CACHE_DIR;
+
+    /// 内存中最多保留的缓存数，超过时删除最久没有使用的缓存
+    inline static size_t MAX_ENTRIES = 64;
+
+    /// 磁盘缓存容量 (bytes)，超过时按写入时间删除最旧的缓存
+    inline static size_t CAPACITY = 16 * 1024 * 1024;
+
+private:
+    struct Item {
+        Entry entry;
+        std::list<std::string>::iterator position;
+    };
+
+    std::unordered_map<std::string, Item> entries;
+    std::list<std::string> order;  // 最近使用的排在前面
+    size_t diskBytes = 0;          // 缓存目录的大小，未统计时为 0
+    std::mutex cacheMutex;
+
+    std::string getPath(const std::string& key);
+
+    /// 需要持有 cacheMutex
+    void insert(const std::string& key, const Entry& entry);
+
+    void save(const std::string& key, const Entry& entry);
+
+    /// 统计缓存目录的大小，超过容量时删除最旧的文件
+    /// 需要持有 cacheMutex
+    void trimDisk();
+};
+
+}  // namespace bilibili
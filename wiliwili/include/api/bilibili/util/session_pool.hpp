@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cpr/cpr.h>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/singleton.hpp"
+
+namespace bilibili {
+
+using SessionPtr = std::shared_ptr<cpr::Session>;
+
+/// 按域名复用 cpr::Session
+/// 同一个 Session 内 curl 会保持与服务器的长连接，
+/// 后续请求可以跳过 TCP 连接与 TLS 握手
+class SessionPool : public Singleton<SessionPool> {
+public:
+    /// 获取一个 Session，当前域名连接数已满时会等待其他请求归还
+    /// 返回值析构时 Session 会自动归还到连接池
+    SessionPtr acquire(const std::string& url, bool post = false);
+
+    /// 释放所有空闲的连接
+    void clear();
+
+    /// 同时与多个域名建立连接，连接保留在连接池中供之后的请求复用
+    /// 每个域名只建立一个连接，在单独的线程中进行，不会让接口请求排队
+    void warmUp(const std::vector<std::string>& urls);
+
+    /// 是否复用连接，关闭后每个请求都会使用新的 Session
+    inline static bool ENABLED = true;
+
+    /// 每个域名最多同时存在的连接数
+    inline static size_t MAX_CONNECTIONS_PER_HOST = 4;
+
+    /// 空闲连接的最长保留时间 (秒)
+    inline static int IDLE_TIMEOUT = 60;
+
+    /// DNS 解析结果的缓存时间 (秒)，所有连接共享同一份缓存
+    inline static int DNS_CACHE_TIMEOUT = 600;
+
+    /// 预先建立连接的超时时间 (毫秒)
+    inline static int WARM_UP_TIMEOUT = 3000;
+
+private:
+    struct IdleSession {
+        cpr::Session* session;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    struct HostSessions {
+        std::list<IdleSession> idle;
+        size_t inUse = 0;
+    };
+
+    std::unordered_map<std::string, HostSessions> hosts;
+    std::mutex poolMutex;
+    std::condition_variable poolCondition;
+
+    /// 将请求按 方法+协议+域名 分组
+    /// POST 请求会在 Session 上留下请求体，所以与 GET 请求分开存放
+    static std::string getHostKey(const std::string& url, bool post);
+
+    static cpr::Session* createSession();
+
+    /// 所有连接共享 DNS 缓存与 TLS 会话
+    static CURLSH* getShare();
+
+    void release(const std::string& key, cpr::Session* session);
+};
+
+}  // namespace bilibili
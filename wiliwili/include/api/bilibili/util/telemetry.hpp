@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cpr/cpr.h>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utils/singleton.hpp"
+
+namespace bilibili {
+
+/// 记录每个接口的网络耗时，用于排查网络缓慢的问题
+/// 只保留最近的 CAPACITY 条记录
+class Telemetry : public Singleton<Telemetry> {
+public:
+    /// 单次请求的记录，耗时单位均为毫秒
+    struct Sample {
+        std::string endpoint;  // 域名 + 路径，不包含请求参数
+        long status    = 0;
+        double dns     = 0;  // 域名解析
+        double connect = 0;  // TCP 连接，复用连接时为 0
+        double tls     = 0;  // TLS 握手，复用连接时为 0
+        double ttfb    = 0;  // 从请求开始到收到第一个字节
+        double total   = 0;  // 完整的传输时间
+        double parse   = 0;  // 解析数据与执行回调
+        size_t bytes   = 0;
+        time_t time    = 0;
+    };
+
+    struct Percentile {
+        double p50 = 0;
+        double p95 = 0;
+    };
+
+    /// 单个接口的统计数据
+    struct Summary {
+        std::string endpoint;
+        size_t count = 0;
+        size_t bytes = 0;
+        Percentile dns, connect, tls, ttfb, total, parse;
+        std::map<long, size_t> status;
+    };
+
+    /// 从刚完成请求的 Session 中读取 curl 记录的耗时
+    static Sample measure(const std::string& url, cpr::Session& session,
+                          const cpr::Response& response);
+
+    void record(const Sample& sample);
+
+    /// 按请求次数从多到少排列
+    std::vector<Summary> summarize();
+
+    /// 导出统计数据与原始记录
+    bool save(const std::string& path);
+
+    void clear();
+
+    /// 是否记录
+    inline static bool ENABLED = true;
+
+    /// 最多保留的记录数量
+    inline static size_t CAPACITY = 512;
+
+private:
+    std::vector<Sample> samples;
+    size_t next = 0;  // 环形缓冲区下一个写入的位置
+    std::mutex telemetryMutex;
+};
+
+}  // namespace bilibili
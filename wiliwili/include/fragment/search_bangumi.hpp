@@ -12,6 +12,7 @@
 #include <atomic>
 #include <memory>
 #include "borealis.hpp"
+#include "bilibili/util/cancel_token.hpp"
 #include "view/recycling_grid.hpp"
 
 class SearchBangumi : public brls::Box {
@@ -29,5 +30,8 @@ public:
 private:
     BRLS_BIND(RecyclingGrid, recyclingGrid, "search/bangumi/recyclingGrid");
 
+    /// 销毁或重新搜索时取消未完成的请求
+    bilibili::CancelGroup requests;
+
     unsigned int requestIndex = 1;
 };
\ No newline at end of file
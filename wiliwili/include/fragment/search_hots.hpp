@@ -6,6 +6,7 @@
 
 #include <borealis.hpp>
 #include <view/auto_tab_frame.hpp>
+#include "bilibili/util/cancel_token.hpp"
 #include "activity/search_activity.hpp"
 
 typedef brls::Event<std::string> UpdateSearchEvent;
@@ -29,4 +30,7 @@ public:
 
 private:
     BRLS_BIND(RecyclingGrid, recyclingGrid, "search/hots/recyclingGrid");
+
+    /// 销毁时取消未完成的请求
+    bilibili::CancelGroup requests;
 };
@@ -15,6 +15,7 @@
 #include "bilibili/result/search_result.h"
 #include "view/recycling_grid.hpp"
 #include "view/video_card.hpp"
+#include "utils/image_helper.hpp"
 #include "activity/player_activity.hpp"
 
 class SearchVideo;
@@ -35,13 +36,22 @@ public:
             (RecyclingGridItemVideoCard*)recycler->dequeueReusableCell("Cell");
 
         bilibili::VideoItemSearchResult& r = this->list[index];
-        item->setCard(r.cover + "@672w_378h_1c.jpg", r.title, r.subtitle,
-                      r.pubdate, r.play, r.danmaku, "");
+        item->setCard(ImageHelper::thumbnail(r.cover, recycler->getItemWidth()),
+                      r.title, r.subtitle, r.pubdate, r.play, r.danmaku, "");
         return item;
     }
 
     size_t getItemCount() override { return list.size(); }
 
+    std::vector<std::string> getImageUrls(RecyclingGrid* recycler, size_t start,
+                                          size_t end) override {
+        std::vector<std::string> urls;
+        for (size_t i = start; i < end; i++)
+            urls.push_back(ImageHelper::thumbnail(this->list[i].cover,
+                                                  recycler->getItemWidth()));
+        return urls;
+    }
+
     void onItemSelected(RecyclingGrid* recycler, size_t index) override {
         auto video = list[index];
         if (!video.bvid.empty()) {
@@ -90,7 +100,10 @@ public:
             fmt::format("{} · {}", r.styles, wiliwili::sec2TimeDate(r.pubdate));
         if (!r.index_show.empty()) subtitle += " · " + r.index_show;
 
-        item->setCard(r.cover + "@312w_420h_1c.jpg", r.title, subtitle, cv,
+        // 封面占 cell 宽度的 30%
+        auto cover = ImageHelper::thumbnail(
+            r.cover, recycler->getItemWidth() * 0.3f, ThumbnailType::VERTICAL);
+        item->setCard(cover, r.title, subtitle, cv,
                       "简介: " + r.desc, r.badge.text, r.badge.bg_color,
                       score_count, score, r.season_type_name, r.areas);
         return item;
@@ -12,6 +12,7 @@
 #include <atomic>
 #include <memory>
 #include <borealis.hpp>
+#include "bilibili/util/cancel_token.hpp"
 #include "view/auto_tab_frame.hpp"
 
 class RecyclingGrid;
@@ -31,5 +32,8 @@ public:
 private:
     BRLS_BIND(RecyclingGrid, recyclingGrid, "search/video/recyclingGrid");
 
+    /// 销毁或重新搜索时取消未完成的请求
+    bilibili::CancelGroup requests;
+
     unsigned int requestIndex = 1;
 };
\ No newline at end of file
@@ -21,6 +21,15 @@ public:
 
     void getUnixTime();
 
+    /// 展示各个接口的耗时统计
+    void showTelemetry();
+
+    /// 展示纹理图集与纹理上传的统计
+    void showImageStats();
+
+    /// 导出网络请求记录到配置文件夹
+    static void exportTelemetry();
+
     static View* create();
 
 private:
@@ -31,4 +40,11 @@ private:
     BRLS_BIND(brls::Label, labelIP, "setting/net/ip");
     BRLS_BIND(brls::Label, labelDNS, "setting/net/dns");
     BRLS_BIND(brls::Header, headerTest, "setting/net/test/header");
+    BRLS_BIND(brls::Label, labelCoalesced, "setting/net/coalesced");
+    BRLS_BIND(brls::Label, labelCancelled, "setting/net/cancelled");
+    BRLS_BIND(brls::Label, labelAtlas, "setting/net/atlas");
+    BRLS_BIND(brls::Label, labelAtlasUpload, "setting/net/atlasUpload");
+    BRLS_BIND(brls::Label, labelUpload, "setting/net/upload");
+    BRLS_BIND(brls::Box, boxTelemetry, "setting/net/telemetry");
+    BRLS_BIND(brls::Label, labelTelemetryEmpty, "setting/net/telemetry/empty");
 };
\ No newline at end of file
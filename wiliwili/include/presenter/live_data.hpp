@@ -15,13 +15,13 @@ public:
     virtual void onError(const std::string& error) {}
 
     void requestData(int roomid) {
-        bilibili::BilibiliClient::get_live_url(
+        this->requests.add(bilibili::BilibiliClient::get_live_url(
             roomid, defaultQuality,
             [this](const bilibili::LiveUrlResultWrapper& result) {
                 liveUrl = result;
                 onLiveData(result);
             },
-            [this](const std::string& error) { this->onError(error); });
+            [this](const std::string& error) { this->onError(error); }));
     }
 
     static inline int defaultQuality = 10000;
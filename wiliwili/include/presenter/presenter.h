@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include "bilibili/util/cancel_token.hpp"
+
 // 检查异步返回时组件是否已经被销毁
 #define ASYNC_RETAIN                               \
     if (!deletionToken && !deletionTokenCounter) { \
@@ -35,6 +37,16 @@
 
 #define ASYNC_TOKEN this, token, tokenCounter
 
+// 保存 ASYNC_RETAIN 之后发起的请求，组件销毁时取消
+// 被取消的请求不会执行回调，由取消时的回调执行 ASYNC_RELEASE
+#define ASYNC_REQUEST(request)                                        \
+    {                                                                 \
+        bilibili::CancelHandle asyncHandle = request;                 \
+        if (asyncHandle)                                              \
+            asyncHandle->onCancel([ASYNC_TOKEN]() { ASYNC_RELEASE }); \
+        this->requests.add(asyncHandle);                              \
+    }
+
 // 避免多次请求API
 #define CHECK_REQUEST \
     if (requesting) return;
@@ -46,10 +58,13 @@ class Presenter {
 public:
     virtual ~Presenter() {
         if (deletionToken) *deletionToken = true;
+        requests.cancel();
     }
 
 protected:
     bool* deletionToken       = nullptr;
     int* deletionTokenCounter = nullptr;
     bool requesting           = false;
+    /// 组件销毁时取消未完成的请求
+    bilibili::CancelGroup requests;
 };
\ No newline at end of file
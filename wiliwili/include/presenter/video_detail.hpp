@@ -8,6 +8,8 @@
 #include "bilibili.h"
 #include "bilibili/result/video_detail_result.h"
 
+class DanmakuItem;
+
 // 指明一个id的类型
 enum class PGC_ID_TYPE {
     SEASON_ID,  // 剧ID
@@ -36,6 +38,10 @@ public:
     virtual void onVideoRelationInfo(const bilibili::VideoRelation& result) {}
     virtual void onRelatedVideoList(
         const bilibili::VideoDetailListResult& result) {}
+    virtual void onNextVideoPlayUrl(unsigned int cid,
+                                    const bilibili::VideoUrlResult& result) {}
+    virtual void onNextVideoDanmaku(unsigned int cid,
+                                    const std::vector<DanmakuItem>& items) {}
 
     // todo: 获取视频合集
 
@@ -77,6 +83,10 @@ public:
     /// 获取视频弹幕
     void requestVideoDanmaku(const unsigned int cid);
 
+    /// 预加载下一P或下一集的播放地址与弹幕，不影响正在播放的视频
+    void requestNextVideo(const std::string& bvid, unsigned int cid,
+                          bool season);
+
     /// 上报播放进度
     void reportHistory(unsigned int aid, unsigned int cid,
                        unsigned int progress = 0, int type = 3);
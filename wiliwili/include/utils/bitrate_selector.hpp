@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// DASH 视频流的码率自适应
+/// 根据 mpv 的下载速度估计可用带宽，结合已缓冲的时长与卡顿选择视频流
+/// 缓冲不足且带宽不够时直接降到合适的码率，缓冲充足时每次只提高一级
+/// 不依赖 mpv 与网络，时间由调用者传入，可以用模拟的网速数据测试
+class BitrateSelector {
+public:
+    /// 按照估计的带宽限制初始的码率，没有足够的数据时返回 index
+    /// bitrates 为候选视频流的码率 (bps)，需要从低到高排列
+    size_t getStartIndex(const std::vector<unsigned int>& bitrates,
+                         size_t index) const;
+
+    /// 设置候选视频流与当前使用的序号，time 为单调递增的秒数
+    void setBitrates(const std::vector<unsigned int>& bitrates, size_t index,
+                     double time);
+
+    /// 设置 mpv 的缓存上限 (bytes)，为 0 时只预读 READAHEAD_TIME 秒
+    /// 缓存容纳不下 HIGH_BUFFER 秒的视频时按照缓存能容纳的时长降低缓冲阈值
+    void setCacheSize(int64_t bytes) { cacheSize = bytes; }
+
+    /// 记录一次下载速度 (Bps) 与已缓冲的时长 (秒)，返回应使用的序号
+    /// 缓存已满或暂停时 (limited) 下载速度取决于播放速度而不是带宽，
+    /// 与下载速度为 0 时一样不更新带宽估计
+    size_t update(double time, int64_t speed, double buffer, bool limited);
+
+    /// 播放卡顿时立即降低码率，返回应使用的序号
+    size_t reportStall(double time);
+
+    size_t getIndex() const { return index; }
+
+    /// 估计的可用带宽 (bps)，数据不足时返回 0
+    double getEstimate() const;
+
+    /// 是否自动切换码率
+    inline static bool ENABLED = true;
+
+    /// 只使用估计带宽的这一比例，留出余量
+    inline static double SAFETY_FACTOR = 0.8;
+
+    /// 缓冲低于此时长 (秒) 且带宽不足时降低码率
+    inline static double LOW_BUFFER = 8;
+
+    /// 缓冲高于此时长 (秒) 时才提高码率
+    inline static double HIGH_BUFFER = 20;
+
+    /// 缓冲阈值最多为缓存能容纳的时长的这一比例
+    inline static double HIGH_BUFFER_RATIO = 0.75;
+
+    /// 缓冲达到缓存能容纳的时长的这一比例时视为缓存已满
+    inline static double CACHE_FULL = 0.9;
+
+    /// 不使用缓存时 mpv 预读的时长 (秒)，即 demuxer-readahead-secs 的默认值
+    inline static double READAHEAD_TIME = 1;
+
+    /// 切换码率后至少间隔此时间 (秒) 才再次提高码率
+    inline static double SWITCH_INTERVAL = 15;
+
+    /// 缓冲超过此时间 (秒) 视为卡顿
+    inline static double STALL_TIME = 2;
+
+private:
+    /// 按时间加权的指数移动平均
+    struct Average {
+        double halfLife = 0;  // 半衰期 (秒)
+        double value    = 0;  // 未修正的平均值
+        double weight   = 0;  // 累计的采样时间 (秒)
+
+        void add(double duration, double sample);
+
+        double get() const;
+    };
+
+    std::vector<unsigned int> bitrates;
+    size_t index      = 0;
+    Average fast      = {3};
+    Average slow      = {10};
+    double lastSample = -1;  // 上一次采样的时间
+    double lastSwitch = 0;   // 上一次切换码率的时间
+    int64_t cacheSize = -1;  // mpv 的缓存上限 (bytes)，未知时为 -1
+
+    /// 估计的带宽能够支持的最高码率的序号
+    size_t getTarget(const std::vector<unsigned int>& list) const;
+
+    /// 当前码率下缓存能容纳的时长 (秒)
+    double getCacheTime() const;
+
+    size_t switchTo(size_t target, double time);
+};
@@ -2,80 +2,60 @@
 // Created by fang on 2022/9/17.
 //
 
-#include <stdexcept>
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
 
 #include "utils/singleton.hpp"
 
-template <typename K, typename T>
-struct Node {
-    K key;
-    T value;
-    Node(K k, T v) : key(k), value(v) {}
-};
-template <typename K, typename T>
-class LRUCache {
+/// 图片纹理缓存，按纹理占用的显存计算容量
+/// 纹理被图片引用时不会被移除，移除的纹理会立即删除
+/// 只能在主线程中使用
+class TextureCache : public Singleton<TextureCache> {
 public:
-    LRUCache(int c, T defaultValue) : capacity(c), defaultValue(defaultValue) {
-        if (c < 1) throw std::logic_error("Cache capacity cannot less than 1.");
-    }
+    /// 获取缓存的纹理并增加引用计数，不存在时返回 0
+    int getCache(const std::string& url);
 
-    T get(K key) {
-        if (cacheMap.find(key) == cacheMap.end()) {
-            return defaultValue;
-        }
-        cacheList.splice(cacheList.begin(), cacheList, cacheMap[key]);
-        cacheMap[key] = cacheList.begin();
-        return cacheMap[key]->value;
-    }
-    void set(K key, T value) {
-        if (cacheMap.find(key) == cacheMap.end()) {
-            if (cacheList.size() == capacity) {
-                cacheMap.erase(cacheList.back().key);
-                cacheList.pop_back();
-            }
-            cacheList.push_front(Node<K, T>(key, value));
-            cacheMap[key] = cacheList.begin();
-        } else {
-            cacheMap[key]->value = value;
-            cacheList.splice(cacheList.begin(), cacheList, cacheMap[key]);
-            cacheMap[key] = cacheList.begin();
-        }
-    }
+    /// 是否已经缓存，不增加引用计数
+    bool hasCache(const std::string& url) const { return urls.count(url) > 0; }
 
-    void setCapacity(int c) {
-        if (c < 1) throw std::logic_error("Cache capacity cannot less than 1.");
-        this->capacity = c;
-        while (cacheList.size() > capacity) {
-            cacheMap.erase(cacheList.back().key);
-            cacheList.pop_back();
-        }
-    }
+    /// 缓存纹理，引用计数为 1
+    /// 返回应当使用的纹理：已经存在相同链接的纹理时，删除新纹理并返回已有的纹理
+    int addCache(const std::string& url, int texture);
 
-    std::list<Node<K, T>>& getCacheList() { return cacheList; }
-
-private:
-    int capacity = 1;
-    T defaultValue;
-    std::list<Node<K, T>> cacheList;
-    std::unordered_map<K, typename std::list<Node<K, T>>::iterator> cacheMap;
-};
+    /// 减少引用计数，不在缓存中的纹理会被忽略
+    void release(int texture);
 
-class TextureCache : public Singleton<TextureCache> {
-public:
-    int getCache(const std::string& url) { return cache.get(url); }
+    /// 设置缓存容量 (MB)
+    void setCapacity(size_t size);
 
-    void addCache(const std::string& url, int texture) {
-        if (texture <= 0) return;
+    /// 缓存中所有纹理占用的显存 (bytes)
+    size_t getBytes() const { return bytes; }
 
-        cache.set(url, texture);
-    }
+    /// 正在被图片引用的纹理占用的显存 (bytes)
+    size_t getLiveBytes() const { return liveBytes; }
 
-    void clean() {
-        auto vg = brls::Application::getNVGContext();
-        for (auto& i : cache.getCacheList()) {
-            nvgDeleteImage(vg, i.value);
-        }
-    }
+    /// 删除所有纹理
+    void clean();
 
-    LRUCache<std::string, int> cache = LRUCache<std::string, int>(200, 0);
-};
\ No newline at end of file
+private:
+    struct Texture {
+        std::string url;
+        int texture  = 0;
+        size_t bytes = 0;
+        int refs     = 0;
+    };
+
+    std::list<Texture> textures;  // 最近使用的排在前面
+    std::unordered_map<std::string, std::list<Texture>::iterator> urls;
+    std::unordered_map<int, std::list<Texture>::iterator> ids;
+
+    size_t capacity  = 64 * 1024 * 1024;
+    size_t bytes     = 0;
+    size_t liveBytes = 0;
+
+    /// 从最久没有使用的纹理开始删除，直到不超过缓存容量
+    void trim();
+};
@@ -21,8 +21,11 @@ enum class SettingItem {
     HISTORY_REPORT,
     PLAYER_BOTTOM_BAR,
     PLAYER_LOW_QUALITY,
+    PLAYER_DIRECT_RENDER,
+    PLAYER_DEBUG_INFO,
+    PLAYER_ABR,
     PLAYER_INMEMORY_CACHE,
-    TEXTURE_CACHE_NUM,
+    TEXTURE_CACHE_SIZE,
     OPENCC_ON,
     CUSTOM_UPDATE_API,
 };
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/// 在子线程中解码好的 RGBA 数据
+struct ImageData {
+    int width  = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+/// 解码图片，图片远大于显示尺寸 (width x height 像素) 时顺便缩小
+/// 不依赖图形接口，可以在任意线程中调用，解码失败时返回 nullptr
+std::shared_ptr<ImageData> decodeImage(const std::string& data, float width,
+                                       float height);
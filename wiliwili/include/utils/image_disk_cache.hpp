@@ -0,0 +1,58 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "utils/singleton.hpp"
+
+/// 图片的磁盘缓存
+/// 图片链接的内容不会变化，下载过的封面与头像保存在磁盘上，下次启动时直接读取
+/// 按照索引文件中记录的使用顺序删除最久没有使用的图片，可以在多个线程中同时读写
+class ImageDiskCache : public Singleton<ImageDiskCache> {
+public:
+    /// 读取缓存的图片
+    bool get(const std::string& url, std::string& data);
+
+    /// 保存图片，超过容量时删除最久没有使用的图片
+    void put(const std::string& url, const std::string& data);
+
+    /// 读取索引文件，并与缓存目录中的文件对照
+    /// 索引之后写入的图片加入索引，已经不存在的文件从索引中删除
+    void load();
+
+    /// 保存索引文件
+    void save();
+
+    /// 删除所有缓存
+    void clear();
+
+    /// 缓存目录，为空时不缓存
+    inline static std::string CACHE_DIR;
+
+    /// 缓存容量 (bytes)
+    inline static size_t CAPACITY = 200 * 1024 * 1024;
+
+private:
+    struct Entry {
+        std::string key;
+        size_t size = 0;
+    };
+
+    std::list<Entry> entries;  // 最近使用的排在前面
+    std::unordered_map<std::string, std::list<Entry>::iterator> keys;
+    size_t bytes = 0;
+    size_t dirty = 0;  // 索引上次保存后的修改次数
+    std::mutex cacheMutex;
+
+    static std::string getKey(const std::string& url);
+
+    static std::string getPath(const std::string& key);
+
+    /// 需要持有 cacheMutex
+    void trim();
+
+    /// 需要持有 cacheMutex
+    void saveIndex();
+};
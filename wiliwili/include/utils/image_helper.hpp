@@ -6,8 +6,15 @@
 
 #include <borealis.hpp>
 #include <cpr/cpr.h>
+#include <atomic>
 #include <ctime>
+#include <functional>
+#include <mutex>
 #include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "utils/image_queue.hpp"
 
 class ImageCache {
 public:
@@ -19,9 +26,25 @@ public:
     int requestCache(const std::string& url);
 };
 
-class ImageHelper {
+struct ImageData;
+
+/// 缩略图的宽高比例
+enum class ThumbnailType {
+    COVER,     // 16:9 视频封面
+    VERTICAL,  // 3:4 竖版番剧封面
+    AVATAR,    // 1:1 头像
+};
+
+class ImageHelper : public std::enable_shared_from_this<ImageHelper> {
 public:
-    static std::vector<std::shared_ptr<ImageHelper>> imagePool;
+    /// 请求的状态，下载线程只读取状态，状态的修改都在主线程中进行
+    /// 取消请求是例外：通过 compare_exchange 从 LOADING 改为 CANCELLED
+    enum class State {
+        IDLE,       // 空闲，可以用于新的请求
+        LOADING,    // 正在加载
+        CANCELLED,  // 已经取消，等待下载线程结束
+    };
+
     static std::default_random_engine random_engine;
 
     static void init();
@@ -40,8 +63,6 @@ public:
 
     bool isAvailable();
 
-    void setAvailable(bool value);
-
     ImageHelper* load(std::string url);
 
     ImageHelper* into(brls::Image* image);
@@ -49,13 +70,96 @@ public:
     /// 清空图片内容
     static void clear(brls::Image* view);
 
+    /// 根据图片的显示宽度 (dp) 生成最接近的标准尺寸缩略图链接
+    static std::string thumbnail(const std::string& url, float width,
+                                 ThumbnailType type = ThumbnailType::COVER);
+
     brls::Image* getImageView();
 
+    /// 更新正在加载的图片的优先级，只能在主线程中调用
+    /// distance 返回图片所属的 View 与可见区域的距离，小于 0 时不修改
+    static void updatePriority(
+        const std::function<float(brls::View*)>& distance);
+
+    /// 预加载图片并解码到内存中，不创建纹理，只能在主线程中调用
+    /// width 为显示宽度 (dp)，distance 为与可见区域的距离，决定下载顺序
+    static void prefetch(const std::string& url, float width, float distance);
+
+    /// 纹理上传的统计
+    struct UploadStats {
+        size_t frameUploads    = 0;  // 上一次上传的帧中上传的图片数量
+        size_t maxFrameUploads = 0;  // 单帧上传的最多图片数量
+        size_t deferred        = 0;  // 当前推迟到之后的帧上传的图片数量
+        size_t totalDeferred   = 0;  // 累计推迟上传的次数
+    };
+
+    static const UploadStats& getUploadStats();
+
+    /// 最多保留的空闲 ImageHelper 数量
+    inline static size_t FREE_LIST_SIZE = 64;
+
+    /// 同时预加载的最大图片数量
+    inline static size_t PREFETCH_LIMIT = 24;
+
+    /// 预加载的图片解码后占用的最大内存 (bytes)
+    inline static size_t BITMAP_CACHE_SIZE = 32 * 1024 * 1024;
+
+    /// 每一帧上传纹理的时间预算 (us)，超出后剩余的图片在之后的帧中上传
+    inline static int64_t UPLOAD_BUDGET = 4000;
+
 private:
-    bool isCancel  = false;
-    bool available = true;
-    std::mutex availableMutex;
+    /// 正在加载的图片与对应的请求
+    static std::unordered_map<brls::Image*, std::shared_ptr<ImageHelper>>
+        requests;
+
+    /// 空闲的 ImageHelper
+    static std::vector<std::shared_ptr<ImageHelper>> freeList;
+
+    /// 等待下载的请求，按照与可见区域的距离依次下载
+    static ImageQueue<std::shared_ptr<ImageHelper>> pending;
+    friend class ImageQueue<std::shared_ptr<ImageHelper>>;
+
+    /// 正在预加载的图片链接
+    static std::unordered_set<std::string> prefetching;
+
+    /// 解码完成等待上传纹理的请求
+    static std::vector<std::shared_ptr<ImageHelper>> uploads;
+    static bool uploadScheduled;
+    static UploadStats uploadStats;
+
+    /// 在下载线程中取出优先级最高的请求并执行
+    static void runNext();
+
+    /// 读取磁盘缓存，没有缓存时经过准入控制后在线程池中下载
+    void run();
+
+    /// 解码并在主线程中上传纹理，body 为空时结束请求
+    void decode(const std::string& body, bool cached);
+
+    /// 下载图片，失败或取消时返回空字符串
+    std::string download();
+
+    /// 加入上传队列，只能在主线程中调用
+    void queueUpload(std::shared_ptr<ImageData> data);
+
+    /// 在主线程中按照优先级上传纹理，超出时间预算后留到下一帧
+    static void drainUploads();
+
+    /// 上传解码好的图片并显示，AtlasImage 中的小图片放入图集
+    void upload();
+
+    /// 加载结束或取消后在主线程中调用，解除图片的锁定
+    void finish();
+
+    /// 回到空闲状态，空闲列表未满时放回空闲列表
+    void recycle();
+
+    std::atomic<State> state{State::IDLE};
+    std::atomic<float> priority{0};  // 与可见区域的距离，越小越先下载
+    float targetWidth  = 0;
+    float targetHeight = 0;
     brls::View* currentView;
-    brls::Image* imageView;
+    brls::Image* imageView = nullptr;
     std::string imageUrl;
-};
\ No newline at end of file
+    std::shared_ptr<ImageData> bitmap;  // 等待上传的图片
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+/// 等待下载的图片请求，按照与可见区域的距离 (item->priority) 依次取出
+/// 等待期间距离会随着滚动更新，所以每次取出时重新查找最近的请求
+template <typename T>
+class ImageQueue {
+public:
+    void push(const T& item) {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        items.push_back(item);
+    }
+
+    /// 取出距离可见区域最近的请求，距离相同时先加入的优先
+    /// 没有等待的请求时返回 false
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        if (items.empty()) return false;
+        auto next = items.begin();
+        for (auto it = items.begin(); it != items.end(); it++) {
+            if ((*it)->priority < (*next)->priority) next = it;
+        }
+        item = *next;
+        items.erase(next);
+        return true;
+    }
+
+private:
+    std::vector<T> items;
+    std::mutex queueMutex;
+};
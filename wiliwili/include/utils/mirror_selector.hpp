@@ -0,0 +1,79 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "utils/singleton.hpp"
+
+/// 视频 CDN 节点选择
+/// 向候选链接发送小范围的 Range 请求，按首字节时间与下载速度排序
+/// 节点的得分会保存到磁盘，下次启动时直接使用历史最快的节点
+/// 得分过期的节点在播放器缓冲结束后通过 NetworkAdmission 在后台重新测速
+class MirrorSelector : public Singleton<MirrorSelector> {
+public:
+    using Callback = std::function<void(std::vector<std::string>)>;
+
+    /// 按从快到慢的顺序回调，不会等待所有链接测速结束
+    /// 有历史得分时立即回调，否则在第一个足够快的链接测速结束时回调
+    /// 可能在调用者的线程或子线程中回调
+    void rank(const std::vector<std::string>& urls, const Callback& callback);
+
+    /// 只按照节点的历史得分排序，不发送请求
+    std::vector<std::string> sort(std::vector<std::string> urls);
+
+    /// 播放卡顿时降低节点的排名
+    void reportStall(const std::string& url);
+
+    /// 读取节点的历史得分
+    void load();
+
+    void save();
+
+    static std::string getHost(const std::string& url);
+
+    /// 是否测速，关闭后总是使用主链接
+    inline static bool ENABLED = true;
+
+    /// 每个链接测速下载的数据量 (bytes)
+    inline static size_t PROBE_SIZE = 256 * 1024;
+
+    /// 测速得分低于此值 (毫秒) 的节点可以直接使用，不再等待其他节点
+    inline static int FAST_SCORE = 1000;
+
+    /// 测速请求的超时时间 (毫秒)
+    inline static int PROBE_TIMEOUT = 2000;
+
+    /// 缓冲超过此时间后切换到下一个节点 (毫秒)
+    inline static int STALL_TIMEOUT = 6000;
+
+    /// 得分超过此时间 (秒) 的节点才在后台重新测速
+    inline static int64_t PROBE_INTERVAL = 6 * 3600;
+
+    /// 节点得分的保存位置
+    inline static std::string HISTORY_PATH;
+
+private:
+    /// 节点的历史得分：预计下载 PROBE_SIZE 需要的毫秒数，越小越快
+    std::unordered_map<std::string, double> hostScores;
+    /// 节点上一次测速的时间 (unix 秒)
+    std::unordered_map<std::string, int64_t> probeTimes;
+    /// 正在后台测速的节点，避免重复测速
+    std::unordered_set<std::string> probing;
+    std::mutex mirrorMutex;
+
+    /// 测速，返回预计下载 PROBE_SIZE 需要的毫秒数
+    static double probe(const std::string& url);
+
+    /// 将测速结果合并到历史得分中
+    void update(const std::string& host, double score);
+
+    /// 在后台依次测速得分过期的节点
+    void refresh(const std::vector<std::string>& urls);
+
+    /// 需要持有 mirrorMutex
+    double getScore(const std::string& host);
+};
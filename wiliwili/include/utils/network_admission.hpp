@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "bilibili/util/cancel_token.hpp"
+#include "utils/singleton.hpp"
+#include "view/mpv_event.hpp"
+
+/// 后台网络请求的准入控制
+/// 播放器缓冲时暂停封面下载与不重要的接口请求，把带宽让给视频
+/// 不会阻塞调用者的线程，暂时不能开始的请求排队等待
+class NetworkAdmission : public Singleton<NetworkAdmission> {
+public:
+    enum class State {
+        OPEN,       // 不做限制
+        THROTTLED,  // 视频下载速度较慢，限制同时下载的图片数量
+        PAUSED,     // 视频正在缓冲，暂停后台请求
+    };
+
+    using Task = std::function<void()>;
+
+    /// 根据播放器的事件更新状态
+    void onMpvEvent(MpvEventEnum event, int64_t cacheSpeed);
+
+    State getState();
+
+    /// 图片等后台下载，可以开始时执行 task，否则排队到可以开始时执行
+    /// task 可能在主线程或其他下载结束的线程中执行，只应将下载提交到线程池
+    /// 下载结束后需要调用 release
+    void submit(const Task& task);
+
+    /// 后台下载结束后调用，开始下一个排队的下载
+    void release();
+
+    /// 不重要的接口请求，暂停时延迟到恢复后通过 executor 执行
+    void defer(const Task& task);
+
+    /// 延迟发起的接口请求，返回的请求在发起之前也可以取消
+    /// 需要与取消请求在同一线程中执行 (见 setExecutor)
+    bilibili::CancelHandle deferRequest(
+        const std::function<bilibili::CancelHandle()>& request);
+
+    /// 设置执行延迟请求的方式，默认在恢复的线程中直接执行
+    void setExecutor(const std::function<void(Task)>& executor);
+
+    /// 设置定时执行的方式 (毫秒)，用于缓冲时间过长时解除暂停
+    /// 视频完全卡住时 mpv 不再发送事件，不能只依赖 onMpvEvent 检查
+    void setTimer(const std::function<void(int, Task)>& timer);
+
+    /// 是否启用准入控制
+    inline static bool ENABLED = true;
+
+    /// 视频下载速度低于此值时限流 (Bps)
+    inline static int64_t LOW_CACHE_SPEED = 256 * 1024;
+
+    /// 限流时最多同时进行的后台下载数量
+    inline static size_t THROTTLED_CONCURRENCY = 1;
+
+    /// 缓冲超过此时间 (毫秒) 后改为限流，避免后台请求一直等待
+    inline static int MAX_PAUSE = 5000;
+
+    /// 因准入控制而排队的下载数量
+    std::atomic<size_t> waitCount{0};
+
+    /// 被延迟执行的请求数量
+    std::atomic<size_t> deferCount{0};
+
+private:
+    State state    = State::OPEN;
+    size_t running = 0;
+    std::chrono::steady_clock::time_point pauseStart;
+    std::deque<Task> queued;
+    std::vector<Task> deferred;
+    std::function<void(Task)> executor;
+    std::function<void(int, Task)> timer;
+    std::mutex admissionMutex;
+
+    void setState(State value);
+
+    /// 暂停超过 MAX_PAUSE 时改为限流
+    void checkPause();
+
+    void updateCacheSpeed(int64_t cacheSpeed);
+
+    /// 需要持有 admissionMutex
+    bool admissible();
+
+    /// 取出可以开始的下载，需要持有 admissionMutex
+    std::vector<Task> admit();
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QrCode.hpp>
+#include <cstring>
+#include <vector>
+
+/// 将二维码的模块按照最近邻缩放写入 size x size 的 RGBA 数据，不经过 SVG
+/// border 为四周空白的模块数，dark 与 light 为模块与背景的 RGBA 颜色
+inline void renderQRCode(const qrcodegen::QrCode& qr, int border, int size,
+                         const unsigned char* dark, const unsigned char* light,
+                         unsigned char* pixels) {
+    int modules = qr.getSize() + border * 2;
+    // 每一列对应的模块在第一行中计算
+    std::vector<int> columns(size);
+    for (int x = 0; x < size; x++) columns[x] = x * modules / size - border;
+    for (int y = 0; y < size; y++) {
+        int row            = y * modules / size - border;
+        unsigned char* dst = pixels + (size_t)y * size * 4;
+        for (int x = 0; x < size; x++, dst += 4)
+            memcpy(dst, qr.getModule(columns[x], row) ? dark : light, 4);
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+/// 在正方形区域中按行 (shelf) 分配矩形，用于纹理图集
+/// 每一行的高度由第一个放入的矩形决定，之后只放入不高于该行的矩形
+/// 不记录已经分配的矩形，删除矩形后需要通过 repack 重新排列
+class ShelfPacker {
+public:
+    /// 矩形的位置，放不下时为 (-1, -1)
+    using Position = std::pair<int, int>;
+
+    /// size 为区域的边长，padding 为矩形之间的间隔
+    explicit ShelfPacker(int size, int padding = 1)
+        : size(size), padding(padding) {}
+
+    /// 分配空间，空间不足时返回 false
+    bool allocate(int width, int height, int& x, int& y);
+
+    /// 清空后按照从高到低的顺序重新放入矩形，同一行中的矩形高度接近
+    /// sizes 为 (宽, 高)，返回的位置与 sizes 的顺序相同
+    std::vector<Position> repack(const std::vector<Position>& sizes);
+
+    void clear() { shelves.clear(); }
+
+    int getSize() const { return size; }
+
+private:
+    struct Shelf {
+        int y      = 0;
+        int height = 0;
+        int x      = 0;  // 下一个矩形的位置
+    };
+
+    int size;
+    int padding;
+    std::vector<Shelf> shelves;
+};
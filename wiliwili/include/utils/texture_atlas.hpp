@@ -0,0 +1,92 @@
+#pragma once
+
+#include <borealis.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/shelf_packer.hpp"
+#include "utils/singleton.hpp"
+
+/// 小图片的纹理图集
+/// 图标、头像与角标等小图片共用一张纹理，连续绘制时不需要切换纹理
+/// 也不会为每张小图片单独分配显存
+/// 按行 (shelf) 分配空间，空间不足时删除不再使用的图片并重新排列剩余的图片
+/// 重新排列后放不下的图片改用单独的纹理，调用者不需要区分
+/// 只能在主线程中使用
+class TextureAtlas : public Singleton<TextureAtlas> {
+public:
+    /// 图集的使用统计
+    struct Stats {
+        size_t images      = 0;  // 图集中的图片数量，即少创建的纹理数量
+        size_t standalone  = 0;  // 放不进图集而使用单独纹理的图片数量
+        size_t draws       = 0;  // 从图集中绘制的次数
+        size_t bindsSaved  = 0;  // 连续绘制图集中的图片时省去的纹理切换次数
+        size_t evictions   = 0;  // 被删除的图片数量
+        size_t defrags     = 0;  // 重新排列的次数
+        size_t uploadBytes = 0;  // 累计上传的数据量
+    };
+
+    /// 获取图片并增加引用计数，不存在时返回 false
+    bool getCache(const std::string& key);
+
+    /// 是否已经缓存，不增加引用计数
+    bool hasCache(const std::string& key) const {
+        return regions.count(key) > 0;
+    }
+
+    /// 图片的尺寸 (像素)，图片不存在时返回 false
+    bool getSize(const std::string& key, int& width, int& height) const;
+
+    /// 将 RGBA 图片加入图集，引用计数为 1
+    /// 图片超过 MAX_IMAGE_SIZE 或图集已满时返回 false，此时应使用单独的纹理
+    bool addCache(const std::string& key, int width, int height,
+                  const unsigned char* data);
+
+    /// 减少引用计数，不再使用的图片在空间不足时被删除
+    void release(const std::string& key);
+
+    /// 生成将图片绘制到 (x, y, width, height) 的画笔，图片不存在时返回 false
+    bool getPaint(NVGcontext* vg, const std::string& key, float x, float y,
+                  float width, float height, NVGpaint& paint);
+
+    /// 绘制其他纹理后调用，用于统计纹理切换次数
+    void resetBinding() { this->bound = false; }
+
+    const Stats& getStats() const { return stats; }
+
+    /// 图集的边长 (像素)
+    inline static int ATLAS_SIZE = 1024;
+
+    /// 加入图集的图片的最大边长 (像素)
+    inline static int MAX_IMAGE_SIZE = 128;
+
+private:
+    struct Region {
+        int x       = 0;
+        int y       = 0;
+        int width   = 0;
+        int height  = 0;
+        int refs    = 0;
+        int texture = 0;  // 重新排列后放不下时使用的单独纹理
+    };
+
+    std::unordered_map<std::string, Region> regions;
+    /// 图片之间间隔 1 像素，避免线性过滤时采样到相邻的图片
+    ShelfPacker packer{ATLAS_SIZE, 1};
+    std::vector<unsigned char> pixels;  // 图集内容，重新排列时使用
+    int texture = 0;
+    bool bound  = false;  // 上一次绘制的是否为图集
+    /// 修改后还没有上传的区域，dirtyX1 <= dirtyX0 时没有修改
+    int dirtyX0 = 0, dirtyY0 = 0, dirtyX1 = 0, dirtyY1 = 0;
+    Stats stats;
+
+    /// 删除不再使用的图片，剩余的图片按高度重新排列
+    void defragment();
+
+    /// 记录需要重新上传的区域
+    void markDirty(int x, int y, int width, int height);
+
+    /// 上传图集中修改过的区域
+    void flush(NVGcontext* vg);
+};
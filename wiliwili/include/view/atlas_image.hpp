@@ -0,0 +1,32 @@
+#pragma once
+
+#include <borealis.hpp>
+#include <string>
+
+/// 可以从纹理图集中绘制的图片
+/// 头像、角标等较小的网络图片由 ImageHelper 放入 TextureAtlas，不单独创建纹理
+/// 没有使用图集时与 brls::Image 相同
+class AtlasImage : public brls::Image {
+public:
+    AtlasImage();
+
+    ~AtlasImage() override;
+
+    /// 使用图集中的图片，调用者已经增加了图片的引用计数
+    void setAtlasImage(const std::string& key);
+
+    /// 释放当前使用的图集区域或纹理缓存中的纹理
+    void releaseImage();
+
+    /// 图片的原始尺寸 (像素)，用于计算未指定的宽高
+    void getImageSize(float& width, float& height);
+
+    void draw(NVGcontext* vg, float x, float y, float width, float height,
+              brls::Style style, brls::FrameContext* ctx) override;
+
+    static View* create();
+
+protected:
+    /// 图片在图集中的名称，为空时使用单独的纹理
+    std::string atlasKey;
+};
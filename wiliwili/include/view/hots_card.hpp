@@ -15,6 +15,8 @@ public:
 
     void setCard(int order, std::string showName, std::string icon);
 
+    void cacheForReuse() override;
+
     static RecyclingGridItemHotsCard* create();
 
 private:
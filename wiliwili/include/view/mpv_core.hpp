@@ -6,6 +6,7 @@
 
 #include "borealis.hpp"
 #include "utils/singleton.hpp"
+#include "view/mpv_event.hpp"
 #include <mpv/client.h>
 #include <mpv/render_gl.h>
 #include <glad/glad.h>
@@ -24,21 +25,6 @@ struct GLShader {
     GLuint ebo;
 };
 
-typedef enum MpvEventEnum {
-    MPV_LOADED,
-    MPV_PAUSE,
-    MPV_RESUME,
-    MPV_STOP,
-    LOADING_START,
-    LOADING_END,
-    UPDATE_DURATION,
-    UPDATE_PROGRESS,
-    START_FILE,
-    END_OF_FILE,
-    DANMAKU_LOADED,
-    CACHE_SPEED_CHANGE,
-} MpvEventEnum;
-
 typedef brls::Event<MpvEventEnum> MPVEvent;
 
 class DanmakuItem {
@@ -120,6 +106,14 @@ public:
         return ret == 1;
     }
 
+    /// 播放列表中是否还有下一个视频
+    bool hasNext() {
+        int64_t pos = -1, count = 0;
+        get_property("playlist-pos", MPV_FORMAT_INT64, &pos);
+        get_property("playlist-count", MPV_FORMAT_INT64, &count);
+        return pos >= 0 && pos + 1 < count;
+    }
+
     double getPlaybackTime() {
         get_property("pause", MPV_FORMAT_DOUBLE, &this->playback_time);
         return this->playback_time;
@@ -147,6 +141,16 @@ public:
 
     void openglDraw(brls::Rect rect, float alpha = 1.0);
 
+    /// 视频画面的渲染统计
+    struct RenderStats {
+        size_t rendered    = 0;  // 渲染 mpv 画面的次数
+        size_t skipped     = 0;  // 没有新画面而跳过渲染的次数
+        size_t direct      = 0;  // 直接渲染到窗口的次数，包含在 rendered 中
+        int64_t renderTime = 0;  // 渲染画面的累计耗时 (us)
+    };
+
+    const RenderStats &getRenderStats() const { return renderStats; }
+
     mpv_render_context *getContext();
 
     mpv_handle *getHandle();
@@ -165,6 +169,9 @@ public:
     int core_idle          = 0;
     int64_t duration       = 0;  // second
     int64_t cache_speed    = 0;  // Bps
+    double cache_duration  = 0;  // second
+    int cache_idle         = 0;  // 缓存已满，mpv 暂停下载
+    double video_fps       = 0;  // 视频的帧率，未知时为 0
     double playback_time   = 0;
     double percent_pos     = 0;
     int64_t video_progress = 0;
@@ -178,6 +185,12 @@ public:
     inline static bool BOTTOM_BAR    = true;
     inline static bool LOW_QUALITY   = false;
     inline static int INMEMORY_CACHE = 0;
+    // 全屏且不透明时 mpv 直接渲染到窗口，省去一次全屏的纹理绘制
+    inline static bool DIRECT_RENDER = true;
+    // 直接渲染时没有新画面也要每一帧重新渲染，只在视频帧率不低于此值时使用
+    inline static double DIRECT_RENDER_FPS = 48;
+    // 在播放器左上角显示渲染统计
+    inline static bool DEBUG_INFO = false;
     NVGcolor bottomBarColor =
         brls::Application::getTheme().getColor("color/bilibili");
 
@@ -197,10 +210,17 @@ private:
 
     MPVEvent mpvCoreEvent;
 
+    // mpv 有新的画面，需要在下一次绘制时渲染到 texture 中
+    bool redraw = true;
+    RenderStats renderStats;
+
     float vertices[20] = {1.0f, 1.0f,  0.0f, 1.0f,  1.0f,  1.0f, -1.0f,
                           0.0f, 1.0f,  0.0f, -1.0f, -1.0f, 0.0f, 0.0f,
                           0.0f, -1.0f, 1.0f, 0.0f,  0.0f,  1.0f};
 
     /// Will be called in main thread to get events from mpv core
     void eventMainLoop();
+
+    /// 调用 mpv 渲染画面并记录耗时
+    void render(mpv_render_param *params);
 };
@@ -0,0 +1,17 @@
+#pragma once
+
+/// 播放器事件，不依赖 mpv 与 borealis，可以在其他模块中单独使用
+typedef enum MpvEventEnum {
+    MPV_LOADED,
+    MPV_PAUSE,
+    MPV_RESUME,
+    MPV_STOP,
+    LOADING_START,
+    LOADING_END,
+    UPDATE_DURATION,
+    UPDATE_PROGRESS,
+    START_FILE,
+    END_OF_FILE,
+    DANMAKU_LOADED,
+    CACHE_SPEED_CHANGE,
+} MpvEventEnum;
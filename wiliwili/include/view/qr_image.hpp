@@ -6,9 +6,8 @@
 #include <borealis.hpp>
 #include <cpr/cpr.h>
 #include <QrCode.hpp>
-#include <pystring.h>
-#include <fmt/format.h>
 
+#include "utils/qr_helper.hpp"
 #include "view/svg_image.hpp"
 
 using qrcodegen::QrCode;
@@ -33,6 +32,13 @@ public:
             "QRBorder", [this](float value) { this->setQRBorder(value); });
     }
 
+    ~QRImage() override {
+        if (this->qrTexture > 0) {
+            nvgDeleteImage(brls::Application::getNVGContext(), qrTexture);
+            this->clear();
+        }
+    }
+
     void setImageFromQRContent(const std::string value) {
         this->qr = QrCode::encodeText(value.c_str(), QrCode::Ecc::LOW);
         this->updateQR();
@@ -53,30 +59,15 @@ public:
         this->updateQR();
     }
 
-    void updateQR() {
-        unsigned char r, g, b;
-        std::string qr_svg = this->qr.toSvgString(this->QRBorder);
-
-        if (mainColor.r != 0 || mainColor.g != 0 || mainColor.b != 0) {
-            r = mainColor.r * 255;
-            g = mainColor.g * 255;
-            b = mainColor.b * 255;
-            std::string new_main_color =
-                fmt::format("#{:02X}{:02X}{:02X}", r, g, b);
-            qr_svg = pystring::replace(qr_svg, "#000000", new_main_color);
-        }
-
-        if (backgroundColor.r != 1.0 || backgroundColor.g != 1.0 ||
-            backgroundColor.b != 1.0) {
-            r = backgroundColor.r * 255;
-            g = backgroundColor.g * 255;
-            b = backgroundColor.b * 255;
-            std::string new_background_color =
-                fmt::format("#{:02X}{:02X}{:02X}", r, g, b);
-            qr_svg = pystring::replace(qr_svg, "#FFFFFF", new_background_color);
-        }
+    /// 在下一次绘制时按照显示尺寸重新生成二维码
+    void updateQR() { this->qrDirty = true; }
 
-        this->setImageFromSVGString(qr_svg);
+    void draw(NVGcontext* vg, float x, float y, float width, float height,
+              brls::Style style, brls::FrameContext* ctx) override {
+        int size = std::min(width, height) * brls::Application::windowScale;
+        if (size > 0 && (this->qrDirty || size != this->qrSize))
+            this->renderQR(vg, size);
+        SVGImage::draw(vg, x, y, width, height, style, ctx);
     }
 
     static View* create() { return new QRImage(); }
@@ -86,4 +77,38 @@ private:
     NVGcolor mainColor       = nvgRGB(0, 0, 0);
     NVGcolor backgroundColor = nvgRGB(255, 255, 255);
     int QRBorder             = 1;
+    bool qrDirty             = true;
+    int qrSize               = 0;  // 纹理的边长 (像素)
+    int qrTexture            = 0;
+
+    /// 按照显示尺寸生成二维码的纹理
+    void renderQR(NVGcontext* vg, int size) {
+        auto start = std::chrono::steady_clock::now();
+        unsigned char dark[4], light[4];
+        for (int i = 0; i < 4; i++) {
+            dark[i]  = mainColor.rgba[i] * 255;
+            light[i] = backgroundColor.rgba[i] * 255;
+        }
+
+        std::vector<unsigned char> pixels((size_t)size * size * 4);
+        renderQRCode(this->qr, this->QRBorder, size, dark, light,
+                     pixels.data());
+
+        if (this->qrTexture > 0 && size == this->qrSize) {
+            nvgUpdateImage(vg, this->qrTexture, pixels.data());
+        } else {
+            if (this->qrTexture > 0) nvgDeleteImage(vg, this->qrTexture);
+            this->qrTexture = nvgCreateImageRGBA(vg, size, size,
+                                                 NVG_IMAGE_NEAREST,
+                                                 pixels.data());
+            this->innerSetImage(this->qrTexture);
+        }
+        this->qrSize  = size;
+        this->qrDirty = false;
+        brls::Logger::debug(
+            "render qr {}x{}: {}us", size, size,
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+    }
 };
\ No newline at end of file
@@ -79,6 +79,16 @@ public:
      */
     virtual void onItemSelected(RecyclingGrid* recycler, size_t index) {}
 
+    /*
+     * Asks the data source for the image urls of items in [start, end).
+     * Used to prefetch images before the cells are created,
+     * empty urls are skipped.
+     */
+    virtual std::vector<std::string> getImageUrls(RecyclingGrid* recycler,
+                                                  size_t start, size_t end) {
+        return {};
+    }
+
     virtual void clearData() = 0;
 };
 
@@ -128,6 +138,9 @@ public:
     /// 当前数据总行数
     size_t getRowCount();
 
+    /// 单个 cell 的宽度
+    float getItemWidth();
+
     /// 导航到页面尾部时触发回调函数
     void onNextPage(const std::function<void()>& callback = nullptr);
 
@@ -162,6 +175,12 @@ public:
     /// 瀑布流模式，每一项高度不固定（仅在spanCount为1时可用）
     bool isFlowMode = false;
 
+    /// 预加载接下来多长时间内会滑过的图片 (秒)
+    float prefetchTime = 0.6;
+
+    /// 最多预加载的行数
+    int maxPrefetchLine = 6;
+
 private:
     RecyclingGridDataSource* dataSource = nullptr;
     bool layouted                       = false;
@@ -194,6 +213,14 @@ private:
     //检查宽度是否有变化
     bool checkWidth();
 
+    // 按照 cell 与可见区域的距离更新图片的下载顺序
+    void updateImagePriority(const brls::Rect& visibleFrame);
+
+    // 根据滑动速度预加载滑动方向上还没有创建的 cell 的图片
+    void prefetchImages();
+    float lastContentOffset   = 0;
+    brls::Time lastScrollTime = 0;
+
     // 回收列表项
     void queueReusableCell(RecyclingGridItem* cell);
 
@@ -9,7 +9,9 @@
 #include <QrCode.hpp>
 #include <lunasvg.h>
 
-class SVGImage : public brls::Image {
+#include "view/atlas_image.hpp"
+
+class SVGImage : public AtlasImage {
 public:
     SVGImage();
 
@@ -17,18 +19,21 @@ public:
 
     void setImageFromSVGFile(const std::string value);
 
-    void setImageFromSVGString(const std::string value);
-
-    void updateBitmap();
-
-    //todo: 窗口大小调整后 图像模糊
-    //    void invalidateImageBounds(){
-    //        this->updateBitmap();
-    //        Image::invalidateImageBounds();
-    //    }
+    void draw(NVGcontext* vg, float x, float y, float width, float height,
+              brls::Style style, brls::FrameContext* ctx) override;
 
     static View* create();
 
 private:
-    std::unique_ptr<lunasvg::Document> document = nullptr;
+    /// 正在显示或加载的 SVG 文件与渲染尺寸 (像素)
+    /// 显示尺寸改变时按照新的尺寸重新渲染
+    std::string svgFile, svgKey;
+    int svgWidth = 0, svgHeight = 0;
+
+    /// 使用已经渲染好的图片，不存在时返回 false
+    bool useCache(const std::string& key);
+
+    /// 缓存子线程中渲染好的图片，仍需要显示时替换当前的图片
+    void applyBitmap(const std::string& key, int width, int height,
+                     const unsigned char* data);
 };
\ No newline at end of file
@@ -22,9 +22,7 @@ class UserInfoView : public brls::Box {
 public:
     UserInfoView() { this->inflateFromXMLRes("xml/views/user_info.xml"); }
 
-    ~UserInfoView() {
-        //        ImageHelper::clear(this->avatarView);
-    }
+    ~UserInfoView() { ImageHelper::clear(this->avatarView); }
 
     void setUserInfo(std::string avatar, std::string username,
                      std::string misc) {
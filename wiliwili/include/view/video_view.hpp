@@ -38,6 +38,14 @@ public:
 
     void setUrl(const std::vector<EDLUrl>& edl_urls, int progress = 0);
 
+    /// 将视频加入播放列表，当前视频播放结束后直接播放
+    void appendUrl(std::string url, std::string audio = "");
+
+    void appendUrl(const std::vector<EDLUrl>& edl_urls);
+
+    /// 切换当前视频的视频流，保留音频、已缓冲的数据与播放列表
+    void switchVideo(const std::string& url);
+
     void resume();
 
     void pause();
@@ -111,6 +119,9 @@ public:
 
     void buttonProcessing();
 
+    /// 每秒更新一次渲染统计
+    void updateDebugInfo();
+
 private:
     bool allowFullscreen  = true;
     VideoState videoState = VideoState::STOPPED;
@@ -140,11 +151,19 @@ private:
     MPVCore* mpvCore;
     brls::Rect oldRect = brls::Rect(-1, -1, -1, -1);
     int danmakuFont    = 0;
+    bool externalVideo = false;  // 当前的视频流由 switchVideo 加入
     std::vector<DanmakuItem> danmakuData;
 
     bool closeOnEndOfFile = true;  // 全屏时 播放结束自动取消全屏
 
+    static std::string getEDLUrl(const std::vector<EDLUrl>& edl_urls);
+
+    static std::string getExtra(int progress, const std::string& audio);
+
     //DEBUG
     BRLS_BIND(brls::Box, videoLayerDebug, "video/layer/debug");
+    BRLS_BIND(brls::Label, videoDebugLabel, "video/debug/render");
+    brls::Time debugUpdateTime = 0;
+    MPVCore::RenderStats debugStats;
     BRLS_BIND(brls::Box, videoLayerDanmaku, "video/layer/danmaku");
 };
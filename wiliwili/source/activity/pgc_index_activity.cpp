@@ -8,6 +8,7 @@
 #include "view/recycling_grid.hpp"
 #include "view/video_card.hpp"
 #include "view/auto_tab_frame.hpp"
+#include "utils/image_helper.hpp"
 
 using namespace brls::literals;
 
@@ -309,8 +310,9 @@ public:
                 "Cell");
 
         auto& r = this->list[index];
-        item->setCard(r.cover + "@312w_420h_1c.jpg", r.title, r.index_show,
-                      r.badge_info, "", r.order);
+        item->setCard(ImageHelper::thumbnail(r.cover, recycler->getItemWidth(),
+                                             ThumbnailType::VERTICAL),
+                      r.title, r.index_show, r.badge_info, "", r.order);
         return item;
     }
 
@@ -13,13 +13,16 @@
 #include "fmt/format.h"
 #include "utils/number_helper.hpp"
 #include "utils/config_helper.hpp"
+#include "utils/image_helper.hpp"
+#include "utils/mirror_selector.hpp"
 
 using namespace brls::literals;
 
 class DataSourceList : public RecyclingGridDataSource {
 public:
-    DataSourceList(std::vector<std::string> result, ChangeIndexEvent cb)
-        : data(result), changeEpisodeEvent(cb) {}
+    DataSourceList(std::vector<std::string> result, ChangeIndexEvent cb,
+                   int selected = -1)
+        : data(result), changeEpisodeEvent(cb), selected(selected) {}
 
     RecyclingGridItem* cellForRow(RecyclingGrid* recycler,
                                   size_t index) override {
@@ -28,11 +31,14 @@ public:
 
         auto r = this->data[index];
         item->title->setText(this->data[index]);
-        //        item->setSelected(index == dropdown->getSelected());
+        item->setSelected((int)index == this->selected);
 
         return item;
     }
 
+    /// 标记正在播放的一项，-1 表示没有
+    void setSelected(int index) { this->selected = index; }
+
     size_t getItemCount() override { return data.size(); }
 
     void onItemSelected(RecyclingGrid* recycler, size_t index) override {
@@ -44,6 +50,7 @@ public:
 private:
     std::vector<std::string> data;
     ChangeIndexEvent changeEpisodeEvent;
+    int selected;
 };
 
 class DataSourceUserUploadedVideoList : public RecyclingGridDataSource {
@@ -59,7 +66,10 @@ public:
                 "Cell");
 
         bilibili::UserUploadedVideoResult& r = this->list[index];
-        item->setCard(r.pic + "@672w_378h_1c.jpg", r.title,
+        // 封面占 cell 宽度的 40%
+        item->setCard(ImageHelper::thumbnail(r.pic,
+                                             recycler->getItemWidth() * 0.4f),
+                      r.title,
                       r.author + " · " + wiliwili::sec2TimeDate(r.created),
                       wiliwili::num2w(r.play), wiliwili::num2w(r.video_review),
                       r.length);
@@ -94,7 +104,10 @@ public:
             (RecyclingGridItemRelatedVideoCard*)recycler->dequeueReusableCell(
                 "Cell");
         auto& r = this->list[index];
-        item->setCard(r.pic + "@672w_378h_1c.jpg", r.title,
+        // 封面占 cell 宽度的 40%
+        item->setCard(ImageHelper::thumbnail(r.pic,
+                                             recycler->getItemWidth() * 0.4f),
+                      r.title,
                       r.owner.name + " · " + wiliwili::sec2TimeDate(r.pubdate),
                       wiliwili::num2w(r.stat.view),
                       wiliwili::num2w(r.stat.danmaku),
@@ -178,6 +191,7 @@ void PlayerActivity::onContentAvailable() {
     changePEvent.subscribe([this](int index) {
         brls::Logger::debug("切换分区: {}", index);
         videoDetailPage = videoDetailResult.pages[index];
+        this->onVideoPageInfo();
         this->requestVideoUrl(videoDetailResult.bvid, videoDetailPage.cid);
         //上报历史记录
         this->reportHistory(videoDetailResult.aid, videoDetailPage.cid, 0);
@@ -360,6 +374,46 @@ void PlayerActivity::setCommonData() {
                                lastProgress) {
                         lastProgress = MPVCore::instance().video_progress;
                     }
+                    this->preloadNext();
+                    this->updateBitrate();
+                    break;
+                case MpvEventEnum::START_FILE:
+                    this->playing = false;
+                    if (this->next.queued) this->playNext();
+                    break;
+                case MpvEventEnum::LOADING_START:
+                    if (!this->stalling) {
+                        this->stalling      = true;
+                        this->stallReported = false;
+                        this->stallStart    = std::chrono::steady_clock::now();
+                    }
+                    break;
+                case MpvEventEnum::LOADING_END:
+                    this->stalling = false;
+                    this->playing  = true;
+                    if (this->transitioning) {
+                        this->transitioning = false;
+                        auto gap = std::chrono::steady_clock::now() -
+                                   this->transitionStart;
+                        brls::Logger::info(
+                            "transition gap: {}ms",
+                            std::chrono::duration_cast<
+                                std::chrono::milliseconds>(gap)
+                                .count());
+                    }
+                    break;
+                case MpvEventEnum::MPV_STOP:
+                    this->stalling = false;
+                    this->playing  = false;
+                    // 播放列表即将切换到预加载的视频
+                    if (this->next.queued) {
+                        this->transitioning   = true;
+                        this->transitionStart =
+                            std::chrono::steady_clock::now();
+                    }
+                    break;
+                case MpvEventEnum::CACHE_SPEED_CHANGE:
+                    this->checkStall();
                     break;
                 default:
                     break;
@@ -396,7 +450,10 @@ void PlayerActivity::onVideoInfo(const bilibili::VideoDetailResult& result) {
     // user info
     auto& user = this->userDetailResult;
     this->videoUserInfo->setUserInfo(
-        user.card.face + "@96w_96h_1c.jpg", user.card.name,
+        ImageHelper::thumbnail(user.card.face,
+                               this->videoUserInfo->getAvatar()->getWidth(),
+                               ThumbnailType::AVATAR),
+        user.card.name,
         wiliwili::num2w(user.follower) + "粉丝 · " +
             wiliwili::num2w(user.like_num) + "点赞");
     if (user.card.mid == ProgramConfig::instance().getUserID()) {
@@ -462,12 +519,38 @@ void PlayerActivity::onVideoPageListInfo(
             items.push_back(fmt::format("PV{} {}", i + 1, title));
         }
         container->addView(grid);
-        grid->setDataSource(new DataSourceList(items, changePEvent));
+        grid->setDataSource(
+            new DataSourceList(items, changePEvent, this->getPageIndex()));
         item->setSubtitle(wiliwili::num2w(result.size()));
         return container;
     });
 }
 
+int PlayerActivity::getPageIndex() {
+    auto& pages = videoDetailResult.pages;
+    for (size_t i = 0; i < pages.size(); i++)
+        if (pages[i].cid == videoDetailPage.cid) return (int)i;
+    return -1;
+}
+
+void PlayerActivity::onVideoPageInfo() {
+    int index = this->getPageIndex();
+    if (index < 0 || videoDetailResult.pages.size() <= 1) return;
+    this->video->setTitle(videoDetailResult.title + " - " +
+                          videoDetailPage.part);
+
+    // 分P列表打开过时更新选中项
+    auto tab = this->tabFrame->getTab("wiliwili/player/p"_i18n);
+    if (!tab) return;
+    auto view = (AttachedView*)tab->getAttachedView();
+    if (!view) return;
+    auto grid       = (RecyclingGrid*)view->getChildren()[0];
+    auto datasource = dynamic_cast<DataSourceList*>(grid->getDataSource());
+    if (!datasource) return;
+    datasource->setSelected(index);
+    grid->notifyDataChanged();
+}
+
 void PlayerActivity::onUploadedVideos(
     const bilibili::UserUploadedVideoResultWrapper& result) {
     for (const auto& i : result.list) {
@@ -515,9 +598,54 @@ void PlayerActivity::onUploadedVideos(
     }
 }
 
+/// 主链接与备用链接
+static std::vector<std::string> getMirrors(
+    const std::string& url, const std::vector<std::string>& backup) {
+    std::vector<std::string> urls = {url};
+    urls.insert(urls.end(), backup.begin(), backup.end());
+    return urls;
+}
+
+/// 不超过当前清晰度的 dash 视频流，按码率从低到高排列
+/// index 为默认使用的视频流 (第一个不超过当前清晰度的) 在结果中的序号
+static std::vector<bilibili::DashMedia> getDashVideos(
+    const bilibili::VideoUrlResult& result, size_t& index) {
+    std::vector<bilibili::DashMedia> videos;
+    std::string first;
+    for (const auto& i : result.dash.video) {
+        if (i.id > result.quality) continue;
+        if (videos.empty()) first = i.base_url;
+        videos.push_back(i);
+    }
+    std::stable_sort(videos.begin(), videos.end(),
+                     [](const auto& a, const auto& b) {
+                         return a.bandwidth < b.bandwidth;
+                     });
+    index = 0;
+    for (size_t i = 0; i < videos.size(); i++)
+        if (videos[i].base_url == first) index = i;
+    return videos;
+}
+
+static std::vector<unsigned int> getBandwidths(
+    const std::vector<bilibili::DashMedia>& videos) {
+    std::vector<unsigned int> bandwidths;
+    for (const auto& i : videos) bandwidths.push_back(i.bandwidth);
+    return bandwidths;
+}
+
+/// 单调递增的秒数，用于选择码率
+static double getSeconds() {
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
 void PlayerActivity::onVideoPlayUrl(const bilibili::VideoUrlResult& result) {
     brls::Logger::debug("onVideoPlayUrl quality: {}", result.quality);
-    //todo: 播放失败时可以尝试备用播放链接
+
+    // 重新加载视频时会清空 mpv 的播放列表
+    this->next = NextVideo();
 
     // 进度向前回退5秒，避免当前进度过于接近结尾出现一加载就结束的情况
     int progress = this->getProgress() - 5;
@@ -525,25 +653,35 @@ void PlayerActivity::onVideoPlayUrl(const bilibili::VideoUrlResult& result) {
     if (!result.dash.video.empty()) {
         // dash
         brls::Logger::debug("Video type: dash");
-        for (const auto& i : result.dash.video) {
-            // todo: 相同清晰度的码率选择方案
-            if (result.quality >= i.id) {
-                // 手动设置当前选择的清晰度
-                videoUrlResult.quality = i.id;
-                for (const auto& j : result.dash.audio) {
-                    this->video->setUrl(i.base_url, progress, j.base_url);
-                    break;
-                }
-                break;
-            }
+        // 已有网速估计时，从带宽能够支持的码率开始播放
+        size_t index    = 0;
+        dashVideos      = getDashVideos(result, index);
+        auto bandwidths = getBandwidths(dashVideos);
+        dashIndex       = bitrateSelector.getStartIndex(bandwidths, index);
+        bitrateSelector.setCacheSize((int64_t)MPVCore::INMEMORY_CACHE << 20);
+        bitrateSelector.setBitrates(bandwidths, dashIndex, getSeconds());
+        if (!dashVideos.empty()) {
+            auto& video = dashVideos[dashIndex];
+            // 手动设置当前选择的清晰度
+            videoUrlResult.quality = video.id;
+            std::vector<std::string> audios;
+            if (!result.dash.audio.empty())
+                audios = getMirrors(result.dash.audio[0].base_url,
+                                    result.dash.audio[0].backup_url);
+            this->setMirrorUrl(getMirrors(video.base_url, video.backup_url),
+                               progress, audios);
         }
     } else {
         // flv
         brls::Logger::debug("Video type: flv");
+        dashVideos.clear();
+        bitrateSelector.setBitrates({}, 0, getSeconds());
         if (result.durl.size() == 0) {
             brls::Logger::error("No media");
         } else if (result.durl.size() == 1) {
-            this->video->setUrl(result.durl[0].url, progress);
+            this->setMirrorUrl(
+                getMirrors(result.durl[0].url, result.durl[0].backup_url),
+                progress);
         } else {
             std::vector<EDLUrl> urls;
             for (auto& i : result.durl) {
@@ -556,6 +694,217 @@ void PlayerActivity::onVideoPlayUrl(const bilibili::VideoUrlResult& result) {
     brls::Logger::debug("PlayerActivity::onVideoPlayUrl done");
 }
 
+void PlayerActivity::setMirrorUrl(const std::vector<std::string>& videos,
+                                  int progress,
+                                  const std::vector<std::string>& audios) {
+    this->videoMirrors = videos;
+    this->audioMirrors = audios;
+    this->mirrorIndex  = 0;
+    size_t request     = ++this->mirrorRequest;
+    ASYNC_RETAIN
+    MirrorSelector::instance().rank(
+        videos,
+        [ASYNC_TOKEN, request, progress](std::vector<std::string> urls) {
+            brls::sync([ASYNC_TOKEN, request, progress, urls]() {
+                ASYNC_RELEASE
+                // 测速期间切换了视频或清晰度
+                if (request != this->mirrorRequest) return;
+                this->videoMirrors = urls;
+                // 音频与视频使用相同的一组节点，直接使用视频的测速结果
+                this->audioMirrors =
+                    MirrorSelector::instance().sort(this->audioMirrors);
+                this->playMirror(progress);
+            });
+        });
+}
+
+void PlayerActivity::playMirror(int progress) {
+    if (videoMirrors.empty()) return;
+    size_t videoIndex = std::min(mirrorIndex, videoMirrors.size() - 1);
+    std::string audio;
+    if (!audioMirrors.empty())
+        audio = audioMirrors[std::min(mirrorIndex, audioMirrors.size() - 1)];
+    this->video->setUrl(videoMirrors[videoIndex], progress, audio);
+}
+
+void PlayerActivity::switchMirror() {
+    this->stalling = false;
+    size_t count   = std::max(videoMirrors.size(), audioMirrors.size());
+    if (mirrorIndex + 1 >= count) return;
+    brls::Logger::warning("Playback stalled, switch to mirror {}/{}",
+                          mirrorIndex + 2, count);
+    if (mirrorIndex < videoMirrors.size())
+        MirrorSelector::instance().reportStall(videoMirrors[mirrorIndex]);
+    if (mirrorIndex < audioMirrors.size())
+        MirrorSelector::instance().reportStall(audioMirrors[mirrorIndex]);
+    mirrorIndex++;
+    this->next = NextVideo();
+    this->playMirror(MPVCore::instance().video_progress);
+}
+
+void PlayerActivity::checkStall() {
+    if (!this->stalling) return;
+    auto stallTime = std::chrono::steady_clock::now() - this->stallStart;
+    if (stallTime > std::chrono::milliseconds(MirrorSelector::STALL_TIMEOUT)) {
+        // 缓冲时间过长，切换到下一个 CDN 节点
+        this->switchMirror();
+    } else if (this->playing && !this->stallReported &&
+               stallTime > std::chrono::duration<double>(
+                               BitrateSelector::STALL_TIME)) {
+        // 播放中途卡顿，降低码率
+        this->stallReported = true;
+        this->switchBitrate(bitrateSelector.reportStall(getSeconds()));
+    }
+}
+
+void PlayerActivity::updateBitrate() {
+    if (dashVideos.size() <= 1 || !this->playing) return;
+    auto& mpv = MPVCore::instance();
+    // 缓存已满或暂停时的下载速度取决于播放速度，不能用来估计带宽
+    bool limited = mpv.cache_idle || mpv.isPaused();
+    this->switchBitrate(bitrateSelector.update(
+        getSeconds(), mpv.cache_speed, mpv.cache_duration, limited));
+}
+
+void PlayerActivity::switchBitrate(size_t index) {
+    if (index == dashIndex || index >= dashVideos.size()) return;
+    auto& video = dashVideos[index];
+    brls::Logger::info("Switch bitrate: {}kbps -> {}kbps, quality: {}",
+                       dashVideos[dashIndex].bandwidth / 1000,
+                       video.bandwidth / 1000, video.id);
+    dashIndex              = index;
+    videoUrlResult.quality = video.id;
+    // 只按节点的历史得分排序，不重新测速
+    videoMirrors = MirrorSelector::instance().sort(
+        getMirrors(video.base_url, video.backup_url));
+    mirrorIndex = 0;
+    mirrorRequest++;  // 丢弃正在进行的测速结果
+    // 不重新加载视频，保留音频、已缓冲的数据与预加载的下一个视频
+    this->video->switchVideo(videoMirrors[0]);
+}
+
+void PlayerActivity::preloadNext() {
+    auto& mpv = MPVCore::instance();
+    if (next.index >= 0 || mpv.duration <= 0 ||
+        mpv.duration - mpv.playback_time > PRELOAD_TIME)
+        return;
+
+    auto self = dynamic_cast<PlayerSeasonActivity*>(this);
+    if (self) {
+        auto& episodes = seasonInfo.episodes;
+        for (size_t i = 0; i + 1 < episodes.size(); i++) {
+            if (episodes[i].cid != episodeResult.cid) continue;
+            next.index = i + 1;
+            next.cid   = episodes[i + 1].cid;
+            this->requestNextVideo(episodes[i + 1].bvid, next.cid, true);
+            return;
+        }
+    } else {
+        auto& pages = videoDetailResult.pages;
+        for (size_t i = 0; i + 1 < pages.size(); i++) {
+            if (pages[i].cid != videoDetailPage.cid) continue;
+            next.index = i + 1;
+            next.cid   = pages[i + 1].cid;
+            this->requestNextVideo(videoDetailResult.bvid, next.cid, false);
+            return;
+        }
+    }
+}
+
+void PlayerActivity::onNextVideoPlayUrl(
+    unsigned int cid, const bilibili::VideoUrlResult& result) {
+    // 预加载期间切换了视频
+    if (cid != next.cid || next.queued) return;
+    next.url = result;
+
+    if (!result.dash.video.empty()) {
+        size_t index    = 0;
+        next.dashVideos = getDashVideos(result, index);
+        if (next.dashVideos.empty()) return;
+        next.dashIndex = bitrateSelector.getStartIndex(
+            getBandwidths(next.dashVideos), index);
+        auto& video       = next.dashVideos[next.dashIndex];
+        next.url.quality  = video.id;
+        next.videoMirrors = MirrorSelector::instance().sort(
+            getMirrors(video.base_url, video.backup_url));
+        if (!result.dash.audio.empty())
+            next.audioMirrors = MirrorSelector::instance().sort(
+                getMirrors(result.dash.audio[0].base_url,
+                           result.dash.audio[0].backup_url));
+        std::string audio;
+        if (!next.audioMirrors.empty()) audio = next.audioMirrors[0];
+        this->video->appendUrl(next.videoMirrors[0], audio);
+    } else if (result.durl.size() == 1) {
+        next.videoMirrors = MirrorSelector::instance().sort(
+            getMirrors(result.durl[0].url, result.durl[0].backup_url));
+        this->video->appendUrl(next.videoMirrors[0]);
+    } else if (result.durl.size() > 1) {
+        std::vector<EDLUrl> urls;
+        for (auto& i : result.durl) {
+            urls.emplace_back(EDLUrl(i.url, i.length / 1000.0f));
+        }
+        this->video->appendUrl(urls);
+    } else {
+        brls::Logger::error("No media");
+        return;
+    }
+    next.queued = true;
+    brls::Logger::info("next video queued: {}", cid);
+}
+
+void PlayerActivity::onNextVideoDanmaku(unsigned int cid,
+                                        const std::vector<DanmakuItem>& items) {
+    if (cid != next.cid) return;
+    next.danmaku     = true;
+    next.danmakuData = items;
+}
+
+void PlayerActivity::playNext() {
+    auto self = dynamic_cast<PlayerSeasonActivity*>(this);
+    //上报上一个视频的历史记录
+    if (self) {
+        this->reportHistory(episodeResult.aid, episodeResult.cid,
+                            MPVCore::instance().video_progress, 4);
+    } else {
+        this->reportHistory(videoDetailResult.aid, videoDetailPage.cid,
+                            MPVCore::instance().video_progress);
+    }
+
+    // 重置MPV
+    MPVCore::instance().reset();
+    if (next.danmaku)
+        MPVCore::instance().loadDanmakuData(next.danmakuData);
+    else
+        this->requestVideoDanmaku(next.cid);
+
+    this->videoUrlResult = next.url;
+    this->videoMirrors   = next.videoMirrors;
+    this->audioMirrors   = next.audioMirrors;
+    this->mirrorIndex    = 0;
+    this->mirrorRequest++;
+    this->dashVideos = next.dashVideos;
+    this->dashIndex  = next.dashIndex;
+    bitrateSelector.setBitrates(getBandwidths(dashVideos), dashIndex,
+                                getSeconds());
+
+    if (self) {
+        episodeResult          = seasonInfo.episodes[next.index];
+        episodeResult.progress = 0;
+        this->reportHistory(episodeResult.aid, episodeResult.cid, 0, 4);
+        this->onSeasonEpisodeInfo(episodeResult);
+        this->requestVideoComment(episodeResult.aid, 1);
+        this->requestVideoOnline(episodeResult.bvid, episodeResult.cid);
+    } else {
+        videoDetailPage          = videoDetailResult.pages[next.index];
+        videoDetailPage.progress = 0;
+        this->reportHistory(videoDetailResult.aid, videoDetailPage.cid, 0);
+        this->onVideoPageInfo();
+        this->requestVideoOnline(videoDetailResult.bvid, videoDetailPage.cid);
+    }
+    brls::Logger::info("play next video: {}", next.cid);
+    this->next = NextVideo();
+}
+
 void PlayerActivity::onCommentInfo(
     const bilibili::VideoCommentResultWrapper& result) {
     DataSourceCommentList* datasource =
@@ -756,9 +1105,10 @@ void PlayerSeasonActivity::onSeasonVideoInfo(
                         result.season_title, result.up_info.uname,
                         result.season_id);
 
-    auto avatar = result.up_info.avatar;
-    if (!avatar.empty()) avatar += "@96w_96h_1c.jpg";
-    auto desc = result.season_desc;
+    auto avatar = ImageHelper::thumbnail(
+        result.up_info.avatar, this->videoUserInfo->getAvatar()->getWidth(),
+        ThumbnailType::AVATAR);
+    auto desc   = result.season_desc;
     if (result.rating.score >= 0)
         desc += fmt::format(" - {}分", result.rating.score);
     else
@@ -119,6 +119,8 @@ void SettingActivity::onContentAvailable() {
 
     btnNetworkChecker->registerClickAction([](...) -> bool {
         auto dialog = new brls::Dialog((brls::Box*)new SettingNetwork());
+        dialog->addButton("wiliwili/setting/net/telemetry/export"_i18n,
+                          []() { SettingNetwork::exportTelemetry(); });
         dialog->addButton("hints/ok"_i18n, []() {});
         dialog->open();
         return true;
@@ -198,15 +200,20 @@ void SettingActivity::onContentAvailable() {
         btnOpencc->setVisibility(brls::Visibility::GONE);
     }
 
+    std::vector<int> textureData = {32, 64, 128, 256};
+    int texture = conf.getSettingItem(SettingItem::TEXTURE_CACHE_SIZE, 64);
+    int textureSelect = 1;
+    for (size_t i = 0; i < textureData.size(); i++) {
+        textureSelect = i;
+        if (texture <= textureData[i]) break;
+    }
     selectorTexture->init(
         "wiliwili/setting/app/cache/texture"_i18n,
-        {"100", "200 (" + "hints/preset"_i18n + ")", "300", "400", "500"},
-        conf.getSettingItem(SettingItem::TEXTURE_CACHE_NUM, 200) / 100 - 1,
-        [](int data) {
-            int num = 100 * data + 100;
+        {"32MB", "64MB (" + "hints/preset"_i18n + ")", "128MB", "256MB"},
+        textureSelect, [textureData](int data) {
             ProgramConfig::instance().setSettingItem(
-                SettingItem::TEXTURE_CACHE_NUM, num);
-            TextureCache::instance().cache.setCapacity(num);
+                SettingItem::TEXTURE_CACHE_SIZE, textureData[data]);
+            TextureCache::instance().setCapacity(textureData[data]);
         });
 
     // todo: 从config_helper中实现一个可通用的选项选择方式
@@ -7,6 +7,7 @@
 #include "cpr/cpr.h"
 #include "utils/config_helper.hpp"
 #include "utils/number_helper.hpp"
+#include "utils/network_admission.hpp"
 #include "fmt/format.h"
 #include "borealis/core/logger.hpp"
 #include "borealis/core/i18n.hpp"
@@ -42,22 +43,25 @@ void Analytics::send() {
     nlohmann::json content(package);
     brls::Logger::verbose("report event: {}", content.dump());
 
-    cpr::PostCallback(
-        [](cpr::Response r) {
-            brls::Logger::verbose("report event: status code: {}",
-                                  r.status_code);
-        },
-        cpr::Parameters{
-            {"api_secret", GA_KEY},
-            {"measurement_id", GA_ID},
-        },
+    // 视频缓冲时延迟上报
+    NetworkAdmission::instance().defer([this, content]() {
+        cpr::PostCallback(
+            [](cpr::Response r) {
+                brls::Logger::verbose("report event: status code: {}",
+                                      r.status_code);
+            },
+            cpr::Parameters{
+                {"api_secret", GA_KEY},
+                {"measurement_id", GA_ID},
+            },
 #ifndef VERIFY_SSL
-        cpr::VerifySsl{false},
+            cpr::VerifySsl{false},
 #endif
-        cpr::Url{GA_URL},
-        cpr::Header{{"User-Agent", "wiliwili/" + app_version},
-                    {"Content-Type", "application/json"}},
-        cpr::Body{content.dump()}, cpr::Timeout{4000});
+            cpr::Url{GA_URL},
+            cpr::Header{{"User-Agent", "wiliwili/" + app_version},
+                        {"Content-Type", "application/json"}},
+            cpr::Body{content.dump()}, cpr::Timeout{4000});
+    });
 }
 
 Analytics::Analytics() {
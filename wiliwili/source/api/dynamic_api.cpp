@@ -7,11 +7,11 @@
 
 namespace bilibili {
 
-void BilibiliClient::dynamic_video(
+CancelHandle BilibiliClient::dynamic_video(
     const unsigned int page, const std::string& offset,
     const std::function<void(DynamicVideoListResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<DynamicVideoListResultWrapper>(
+    return HTTP::getResultAsync<DynamicVideoListResultWrapper>(
         Api::DynamicVideo,
         {
             {"page", std::to_string(page)},
@@ -24,10 +24,10 @@ void BilibiliClient::dynamic_video(
         error);
 }
 
-void BilibiliClient::dynamic_up_list(
+CancelHandle BilibiliClient::dynamic_up_list(
     const std::function<void(DynamicUpListResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<DynamicUpListResultWrapper>(
+    return HTTP::getResultAsync<DynamicUpListResultWrapper>(
         Api::DynamicUpList, {{"teenagers_mode", "0"}},
         [callback](const DynamicUpListResultWrapper& wrapper) {
             callback(wrapper);
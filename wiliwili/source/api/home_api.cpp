@@ -4,18 +4,19 @@
 #include "bilibili/util/md5.hpp"
 #include "curl/curl.h"
 #include "bilibili/util/http.hpp"
+#include "bilibili/util/fan_out.hpp"
 #include "bilibili/result/home_pgc_result.h"
 #include "bilibili/result/home_live_result.h"
 
 namespace bilibili {
 
 /// 主页 推荐
-void BilibiliClient::get_recommend(
+CancelHandle BilibiliClient::get_recommend(
     const int index, const int num,
     const std::function<void(RecommendVideoListResultWrapper)>& callback,
     const ErrorCallback& error) {
     //        BilibiliClient::pool.enqueue([=]{
-    HTTP::getResultAsync<RecommendVideoListResultWrapper>(
+    return HTTP::getResultAsync<RecommendVideoListResultWrapper>(
         Api::Recommend,
         {
             {"fresh_idx", std::to_string(index)},
@@ -33,11 +34,11 @@ void BilibiliClient::get_recommend(
 }
 
 /// 主页 热门 热门综合
-void BilibiliClient::get_hots_all(
+CancelHandle BilibiliClient::get_hots_all(
     const int index, const int num,
     const std::function<void(HotsAllVideoListResult, bool)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<HotsAllVideoListResultWrapper>(
+    return HTTP::getResultAsync<HotsAllVideoListResultWrapper>(
         Api::HotsAll,
         {{"pn", std::to_string(index)}, {"ps", std::to_string(num)}},
         [callback](const HotsAllVideoListResultWrapper& wrapper) {
@@ -47,11 +48,11 @@ void BilibiliClient::get_hots_all(
 }
 
 /// 主页 热门 每周推荐列表
-void BilibiliClient::get_hots_weekly_list(
+CancelHandle BilibiliClient::get_hots_weekly_list(
     const std::function<void(HotsWeeklyListResult)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<HotsWeeklyResultWrapper>(
-        Api::HotsWeeklyList, {},
+    return HTTP::getResultCachedAsync<HotsWeeklyResultWrapper>(
+        Api::HotsWeeklyList, {}, 6 * 3600,
         [callback](const HotsWeeklyResultWrapper& wrapper) {
             callback(wrapper.list);
         },
@@ -59,12 +60,12 @@ void BilibiliClient::get_hots_weekly_list(
 }
 
 /// 主页 热门 每周推荐
-void BilibiliClient::get_hots_weekly(
+CancelHandle BilibiliClient::get_hots_weekly(
     const int number,
     const std::function<void(HotsWeeklyVideoListResult, std::string,
                              std::string)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<HotsWeeklyVideoListResultWrapper>(
+    return HTTP::getResultAsync<HotsWeeklyVideoListResultWrapper>(
         Api::HotsWeekly, {{"number", std::to_string(number)}},
         [callback](const HotsWeeklyVideoListResultWrapper& wrapper) {
             callback(wrapper.list, wrapper.config.label, wrapper.reminder);
@@ -73,12 +74,12 @@ void BilibiliClient::get_hots_weekly(
 }
 
 /// 主页 热门 入站必刷
-void BilibiliClient::get_hots_history(
+CancelHandle BilibiliClient::get_hots_history(
     const std::function<void(HotsHistoryVideoListResult, std::string)>&
         callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<HotsHistoryVideoListResultWrapper>(
-        Api::HotsHistory, {},
+    return HTTP::getResultCachedAsync<HotsHistoryVideoListResultWrapper>(
+        Api::HotsHistory, {}, 3600,
         [callback](const HotsHistoryVideoListResultWrapper& wrapper) {
             callback(wrapper.list, wrapper.explain);
         },
@@ -86,36 +87,37 @@ void BilibiliClient::get_hots_history(
 }
 
 /// 主页 热门 排行榜 投稿视频
-void BilibiliClient::get_hots_rank(
+CancelHandle BilibiliClient::get_hots_rank(
     const int rid, const std::string type,
     const std::function<void(HotsRankVideoListResult, std::string)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<HotsRankVideoListResultWrapper>(
-        Api::HotsRank, {{"rid", std::to_string(rid)}, {"type", type}},
+    return HTTP::getResultCachedAsync<HotsRankVideoListResultWrapper>(
+        Api::HotsRank, {{"rid", std::to_string(rid)}, {"type", type}}, 3600,
         [callback](auto wrapper) { callback(wrapper.list, wrapper.note); },
         error);
 }
 
 /// 主页 热门 排行榜 官方
-void BilibiliClient::get_hots_rank_pgc(
+CancelHandle BilibiliClient::get_hots_rank_pgc(
     const int season_type, const int day,
     const std::function<void(HotsRankPGCVideoListResult, std::string)>&
         callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<HotsRankPGCVideoListResultWrapper>(
+    return HTTP::getResultCachedAsync<HotsRankPGCVideoListResultWrapper>(
         Api::HotsRankPGC,
         {{"season_type", std::to_string(season_type)},
          {"day", std::to_string(day)}},
+        3600,
         [callback](auto wrapper) { callback(wrapper.list, wrapper.note); },
         error);
 }
 
 /// 主页 直播推荐
-void BilibiliClient::get_live_recommend(
+CancelHandle BilibiliClient::get_live_recommend(
     int parent_area_id, int area_id, int page, const std::string& source,
     const std::function<void(LiveResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<LiveResultWrapper>(
+    return HTTP::getResultAsync<LiveResultWrapper>(
         Api::LiveFeed,
         {
             {"parent_area_id", std::to_string(parent_area_id)},
@@ -131,11 +133,11 @@ void BilibiliClient::get_live_recommend(
 }
 
 /// 主页 追番列表
-void BilibiliClient::get_bangumi(
+CancelHandle BilibiliClient::get_bangumi(
     int is_refresh, const std::string& cursor,
     const std::function<void(PGCResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<PGCResultWrapper>(
+    return HTTP::getResultAsync<PGCResultWrapper>(
         Api::Bangumi,
         {
             {"is_refresh", std::to_string(is_refresh)},
@@ -145,11 +147,11 @@ void BilibiliClient::get_bangumi(
 }
 
 /// 主页 影视列表
-void BilibiliClient::get_cinema(
+CancelHandle BilibiliClient::get_cinema(
     int is_refresh, const std::string& cursor,
     const std::function<void(PGCResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<PGCResultWrapper>(
+    return HTTP::getResultAsync<PGCResultWrapper>(
         Api::Cinema,
         {
             {"is_refresh", std::to_string(is_refresh)},
@@ -159,79 +161,60 @@ void BilibiliClient::get_cinema(
 }
 
 /// 主页 追番/影视 分类检索
-void BilibiliClient::get_pgc_index(
+CancelHandle BilibiliClient::get_pgc_index(
     const std::string& param, int page,
     const std::function<void(PGCIndexResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<PGCIndexResultWrapper>(
+    return HTTP::getResultAsync<PGCIndexResultWrapper>(
         Api::PGCIndex + "?" + param + "&page=" + std::to_string(page), {},
         [callback](auto wrapper) { callback(wrapper); }, error);
 }
 
 /// 主页 追番/影视 获取分类
-void BilibiliClient::get_pgc_filter(
+CancelHandle BilibiliClient::get_pgc_filter(
     const std::string& index_type,
     const std::function<void(PGCIndexFilterWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<PGCIndexFilterWrapper>(
+    return HTTP::getResultCachedAsync<PGCIndexFilterWrapper>(
         Api::PGCIndexFilter,
         {
             {"type", "2"},
             {"index_type", index_type},
         },
+        24 * 3600,
         [callback](auto wrapper) { callback(wrapper); }, error);
 }
 
 /// 主页 追番/影视 获取全部分类
-void BilibiliClient::get_pgc_all_filter(
+CancelHandle BilibiliClient::get_pgc_all_filter(
     const std::function<void(PGCIndexFilters)>& callback,
     const ErrorCallback& error) {
-    PGCIndexFilters res;
-    BilibiliClient::get_pgc_filter(
-        "1",
-        [callback, error, res](auto wrapper) mutable {
-            wrapper.index_name = "追番";
-            res["1"]           = wrapper;
-            BilibiliClient::get_pgc_filter(
-                "2",
-                [callback, error, res](auto wrapper) mutable {
-                    wrapper.index_name = "电影";
-                    res["2"]           = wrapper;
-                    BilibiliClient::get_pgc_filter(
-                        "5",
-                        [callback, error, res](auto wrapper) mutable {
-                            wrapper.index_name = "电视剧";
-                            res["5"]           = wrapper;
-                            BilibiliClient::get_pgc_filter(
-                                "3",
-                                [callback, error, res](auto wrapper) mutable {
-                                    wrapper.index_name = "纪录片";
-                                    res["3"]           = wrapper;
-                                    BilibiliClient::get_pgc_filter(
-                                        "7",
-                                        [callback, error,
-                                         res](auto wrapper) mutable {
-                                            wrapper.index_name = "综艺";
-                                            res["7"]           = wrapper;
-                                            BilibiliClient::get_pgc_filter(
-                                                "102",
-                                                [callback,
-                                                 res](auto wrapper) mutable {
-                                                    wrapper.index_name =
-                                                        "影视综合";
-                                                    res["102"] = wrapper;
-                                                    callback(res);
-                                                },
-                                                error);
-                                        },
-                                        error);
-                                },
-                                error);
-                        },
-                        error);
-                },
-                error);
+    static const std::vector<std::pair<std::string, std::string>> indexes = {
+        {"1", "追番"},   {"2", "电影"}, {"5", "电视剧"},
+        {"3", "纪录片"}, {"7", "综艺"}, {"102", "影视综合"},
+    };
+    CancelHandle handle = CancelToken::create();
+    auto join           = FanOut<PGCIndexFilters>::create(
+        indexes.size(),
+        [handle, callback](PGCIndexFilters data) {
+            if (handle->finish() && callback) callback(std::move(data));
         },
-        error);
+        [handle, error](const std::string& msg) {
+            if (handle->finish() && error) error(msg);
+        });
+    for (auto& index : indexes) {
+        auto request = BilibiliClient::get_pgc_filter(
+            index.first,
+            [join, index](PGCIndexFilterWrapper wrapper) {
+                wrapper.index_name = index.second;
+                join->resolve([&index, &wrapper](PGCIndexFilters& res) {
+                    res[index.first] = wrapper;
+                });
+            },
+            [join](const std::string& msg) { join->reject(msg); });
+        join->add(request);
+        handle->link(request);
+    }
+    return handle;
 }
 }  // namespace bilibili
\ No newline at end of file
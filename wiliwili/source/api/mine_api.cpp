@@ -13,21 +13,21 @@
 namespace bilibili {
 
 /// get qrcode for login
-void BilibiliClient::get_login_url(
+CancelHandle BilibiliClient::get_login_url(
     const std::function<void(std::string, std::string)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<QrLoginTokenResult>(
+    return HTTP::getResultAsync<QrLoginTokenResult>(
         Api::QrLoginUrl, {},
         [callback](auto wrapper) { callback(wrapper.url, wrapper.oauthKey); },
         error);
 }
 
 /// check if qrcode has been scanned
-void BilibiliClient::get_login_info(
+CancelHandle BilibiliClient::get_login_info(
     const std::string oauthKey,
     const std::function<void(enum LoginInfo)>& callback,
     const ErrorCallback& error) {
-    HTTP::__cpr_post(
+    return HTTP::__cpr_post(
         Api::QrLoginInfo, {}, {{"oauthKey", oauthKey}},
         [callback, error](const cpr::Response& r) {
             try {
@@ -59,37 +59,37 @@ void BilibiliClient::get_login_info(
 }
 
 /// get person info (if login)
-void BilibiliClient::get_my_info(
+CancelHandle BilibiliClient::get_my_info(
     const std::function<void(UserResult)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<UserResult>(
+    return HTTP::getResultAsync<UserResult>(
         Api::MyInfo, {}, [callback](auto user) { callback(user); }, error);
 }
 
 /// 获取用户 关注/粉丝/黑名单数量
-void BilibiliClient::get_user_relation(
+CancelHandle BilibiliClient::get_user_relation(
     const std::string& mid,
     const std::function<void(UserRelationStat)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<UserRelationStat>(Api::UserRelationStat,
-                                           {{"vmid", mid}}, callback, error);
+    return HTTP::getResultAsync<UserRelationStat>(
+        Api::UserRelationStat, {{"vmid", mid}}, callback, error);
 }
 
 /// 获取用户动态的数量
-void BilibiliClient::get_user_dynamic_count(
+CancelHandle BilibiliClient::get_user_dynamic_count(
     const std::string& mid,
     const std::function<void(UserDynamicCount)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<UserDynamicCount>(Api::UserDynamicStat,
-                                           {{"uids", mid}}, callback, error);
+    return HTTP::getResultAsync<UserDynamicCount>(
+        Api::UserDynamicStat, {{"uids", mid}}, callback, error);
 }
 
 /// get person history videos
-void BilibiliClient::get_my_history(
+CancelHandle BilibiliClient::get_my_history(
     const HistoryVideoListCursor& cursor,
     const std::function<void(HistoryVideoResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<HistoryVideoResultWrapper>(
+    return HTTP::getResultAsync<HistoryVideoResultWrapper>(
         Api::HistoryVideo,
         {{"max", std::to_string(cursor.max)},
          {"view_at", std::to_string(cursor.view_at)},
@@ -99,11 +99,11 @@ void BilibiliClient::get_my_history(
 }
 
 /// get person collection list
-void BilibiliClient::get_my_collection_list(
+CancelHandle BilibiliClient::get_my_collection_list(
     const int mid, const int index, const int num,
     const std::function<void(CollectionListResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<CollectionListResultWrapper>(
+    return HTTP::getResultAsync<CollectionListResultWrapper>(
         Api::CollectionList,
         {
             {"platform", "pc"},
@@ -119,11 +119,11 @@ void BilibiliClient::get_my_collection_list(
 }
 
 /// get person collection list
-void BilibiliClient::get_my_collection_list(
+CancelHandle BilibiliClient::get_my_collection_list(
     const std::string& mid, const int index, const int num,
     const std::function<void(CollectionListResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<CollectionListResultWrapper>(
+    return HTTP::getResultAsync<CollectionListResultWrapper>(
         Api::CollectionList,
         {
             {"platform", "pc"},
@@ -139,11 +139,11 @@ void BilibiliClient::get_my_collection_list(
 }
 
 /// get collection video list
-void BilibiliClient::get_collection_video_list(
+CancelHandle BilibiliClient::get_collection_video_list(
     int media_id, const int index, const int num,
     const std::function<void(CollectionVideoListResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<CollectionVideoListResultWrapper>(
+    return HTTP::getResultAsync<CollectionVideoListResultWrapper>(
         Api::CollectionVideoList,
         {
             {"media_id", std::to_string(media_id)},
@@ -159,11 +159,11 @@ void BilibiliClient::get_collection_video_list(
 }
 
 /// get user's upload videos
-void BilibiliClient::get_user_videos(
+CancelHandle BilibiliClient::get_user_videos(
     int mid, int pn, int ps,
     const std::function<void(UserUploadedVideoResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<UserUploadedVideoResultWrapper>(
+    return HTTP::getResultAsync<UserUploadedVideoResultWrapper>(
         Api::UserUploadedVideo,
         {
             {"mid", std::to_string(mid)},
@@ -173,11 +173,11 @@ void BilibiliClient::get_user_videos(
         callback, error);
 }
 
-void BilibiliClient::get_user_videos2(
+CancelHandle BilibiliClient::get_user_videos2(
     int mid, int pn, int ps,
     const std::function<void(UserDynamicVideoResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<UserDynamicVideoResultWrapper>(
+    return HTTP::getResultAsync<UserDynamicVideoResultWrapper>(
         Api::UserDynamicVideo,
         {
             {"mid", std::to_string(mid)},
@@ -187,9 +187,10 @@ void BilibiliClient::get_user_videos2(
         callback, error);
 }
 
-void BilibiliClient::get_unix_time(
+CancelHandle BilibiliClient::get_unix_time(
     const std::function<void(UnixTimeResult)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<UnixTimeResult>(Api::UnixTime, {}, callback, error);
+    return HTTP::getResultAsync<UnixTimeResult>(Api::UnixTime, {}, callback,
+                                                error);
 }
 }  // namespace bilibili
\ No newline at end of file
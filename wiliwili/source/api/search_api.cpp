@@ -8,11 +8,11 @@
 
 namespace bilibili {
 
-void BilibiliClient::search_video(
+CancelHandle BilibiliClient::search_video(
     const std::string &key, const std::string &search_type, unsigned int index,
     const std::string &order, const std::function<void(SearchResult)> &callback,
     const ErrorCallback &error) {
-    HTTP::getResultAsync<SearchResult>(
+    return HTTP::getResultAsync<SearchResult>(
         Api::Search,
         {{"__refresh__", "true"},
          {"_extra", ""},
@@ -34,11 +34,11 @@ void BilibiliClient::search_video(
         [callback](auto data) { callback(data); }, error);
 }
 
-void BilibiliClient::get_search_hots(
+CancelHandle BilibiliClient::get_search_hots(
     int limit, const std::function<void(SearchHotsResultWrapper)> &callback,
     const ErrorCallback &error) {
-    HTTP::getResultAsync<SearchHotsResultWrapper>(
-        Api::SearchHots, {{"limit", std::to_string(limit)}},
+    return HTTP::getResultCachedAsync<SearchHotsResultWrapper>(
+        Api::SearchHots, {{"limit", std::to_string(limit)}}, 600,
         [callback](auto data) { callback(data); }, error);
 }
 
@@ -3,6 +3,8 @@
 //
 
 #include "bilibili/util/http.hpp"
+#include "bilibili/util/session_pool.hpp"
+#include "bilibili/util/telemetry.hpp"
 
 namespace bilibili {
 cpr::Cookies HTTP::COOKIES = cpr::Cookies(false);
@@ -13,18 +15,108 @@ cpr::Header HTTP::HEADERS  = {
      {"Origin", "https://www.bilibili.com"},
 };
 
+/// 解析数据与执行回调的耗时 (毫秒)
+static double getElapsed(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+/// 取消后在下一次进度回调时中断传输
+static cpr::ProgressCallback cancelCallback(const CancelHandle& handle) {
+    return cpr::ProgressCallback(
+        [handle](cpr::cpr_off_t downloadTotal, cpr::cpr_off_t downloadNow,
+                 cpr::cpr_off_t uploadTotal, cpr::cpr_off_t uploadNow,
+                 intptr_t userdata) -> bool {
+            if (!handle || !handle->isCancelled()) return true;
+            if (downloadTotal > downloadNow)
+                CancelToken::CANCELLED_BYTES += downloadTotal - downloadNow;
+            return false;
+        });
+}
+
 cpr::Response HTTP::get(const std::string& url,
                         const cpr::Parameters& parameters, int timeout) {
-    return cpr::Get(cpr::Url{url},
-                    cpr::Header{
-                        {"User-Agent", "NintendoSwitch"},
-                        {"Referer", "https://www.bilibili.com"},
-                    },
-                    parameters, HTTP::COOKIES,
-#ifndef VERIFY_SSL
-            cpr::VerifySsl{false},
-#endif
-                    cpr::Timeout{timeout});
+    auto session = SessionPool::instance().acquire(url);
+    session->SetUrl(cpr::Url{url});
+    session->SetParameters(parameters);
+    session->SetHeader(HTTP::HEADERS);
+    session->SetCookies(HTTP::COOKIES);
+    session->SetTimeout(cpr::Timeout{timeout});
+    // 连接池中的 Session 会保留上一次设置的进度回调
+    session->SetProgressCallback(cancelCallback(nullptr));
+    cpr::Response r = session->Get();
+    Telemetry::instance().record(Telemetry::measure(url, *session, r));
+    return r;
+}
+
+CancelHandle HTTP::__cpr_get(
+    const std::string& url, cpr::Parameters parameters,
+    const std::function<void(const cpr::Response&)>& callback,
+    const cpr::Header& header, CancelHandle handle) {
+    if (!handle) handle = CancelToken::create();
+    cpr::async([url, parameters, callback, header, handle]() {
+        if (handle->isCancelled()) return;
+        cpr::Header h = HTTP::HEADERS;
+        for (auto& i : header) h[i.first] = i.second;
+        cpr::Response r;
+        Telemetry::Sample sample;
+        {
+            auto session = SessionPool::instance().acquire(url);
+            session->SetUrl(cpr::Url{url});
+            session->SetParameters(parameters);
+            session->SetHeader(h);
+            session->SetCookies(HTTP::COOKIES);
+            session->SetTimeout(cpr::Timeout{HTTP::TIMEOUT});
+            session->SetProgressCallback(cancelCallback(handle));
+            r      = session->Get();
+            sample = Telemetry::measure(url, *session, r);
+        }
+        // 先归还连接再处理数据，已取消的请求不再解析数据
+        if (!handle->finish()) return;
+        auto start = std::chrono::steady_clock::now();
+        if (callback) callback(r);
+        sample.parse = getElapsed(start);
+        Telemetry::instance().record(sample);
+    });
+    return handle;
+}
+
+CancelHandle HTTP::__cpr_post(
+    const std::string& url, cpr::Parameters parameters, cpr::Payload payload,
+    const std::function<void(const cpr::Response&)>& callback,
+    const ErrorCallback& error) {
+    CancelHandle handle = CancelToken::create();
+    cpr::async([url, parameters, payload, callback, error, handle]() {
+        if (handle->isCancelled()) return;
+        cpr::Response r;
+        Telemetry::Sample sample;
+        {
+            auto session = SessionPool::instance().acquire(url, true);
+            session->SetUrl(cpr::Url{url});
+            session->SetParameters(parameters);
+            session->SetPayload(payload);
+            session->SetHeader(HTTP::HEADERS);
+            session->SetCookies(HTTP::COOKIES);
+            session->SetTimeout(cpr::Timeout{HTTP::TIMEOUT});
+            session->SetProgressCallback(cancelCallback(handle));
+            r      = session->Post();
+            sample = Telemetry::measure(url, *session, r);
+        }
+        if (!handle->finish()) return;
+        if (r.status_code != 200) {
+            Telemetry::instance().record(sample);
+            ERROR_MSG("Network error. [Status code: " +
+                          std::to_string(r.status_code) + " ]",
+                      -404);
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        if (callback) callback(r);
+        sample.parse = getElapsed(start);
+        Telemetry::instance().record(sample);
+    });
+    return handle;
 }
 
-};  // namespace bilibili
\ No newline at end of file
+};  // namespace bilibili
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <thread>
+
+#include "bilibili/util/response_cache.hpp"
+#include "bilibili/util/md5.hpp"
+#include "pystring.h"
+
+namespace bilibili {
+
+bool ResponseCache::Entry::expired(time_t ttl) const {
+    return std::time(nullptr) - time > ttl;
+}
+
+std::string ResponseCache::getKey(const std::string& url,
+                                  const cpr::Parameters& parameters) {
+    std::vector<std::string> kv;
+    pystring::split(parameters.GetContent(cpr::CurlHolder()), kv, "&");
+    std::sort(kv.begin(), kv.end());
+    return websocketpp::md5::md5_hash_hex(url + "?" + pystring::join("&", kv));
+}
+
+std::string ResponseCache::getPath(const std::string& key) {
+    return CACHE_DIR + "/" + key + ".json";
+}
+
+bool ResponseCache::get(const std::string& key, Entry& entry) {
+    std::unique_lock<std::mutex> lock(cacheMutex);
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        order.splice(order.begin(), order, it->second.position);
+        entry = it->second.entry;
+        return true;
+    }
+    if (CACHE_DIR.empty()) return false;
+
+    std::ifstream readFile(getPath(key));
+    if (!readFile) return false;
+    try {
+        nlohmann::json content;
+        readFile >> content;
+        entry.body         = content.at("body").get<std::string>();
+        entry.etag         = content.at("etag").get<std::string>();
+        entry.lastModified = content.at("last_modified").get<std::string>();
+        entry.time         = content.at("time").get<time_t>();
+    } catch (const std::exception& e) {
+        printf("ResponseCache::get: %s\n", e.what());
+        return false;
+    }
+    this->insert(key, entry);
+    return true;
+}
+
+void ResponseCache::put(const std::string& key, const Entry& entry) {
+    {
+        std::unique_lock<std::mutex> lock(cacheMutex);
+        this->insert(key, entry);
+    }
+    save(key, entry);
+}
+
+void ResponseCache::insert(const std::string& key, const Entry& entry) {
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        it->second.entry = entry;
+        order.splice(order.begin(), order, it->second.position);
+        return;
+    }
+    order.push_front(key);
+    entries[key] = {entry, order.begin()};
+    while (entries.size() > MAX_ENTRIES) {
+        entries.erase(order.back());
+        order.pop_back();
+    }
+}
+
+void ResponseCache::touch(const std::string& key) {
+    Entry entry;
+    {
+        std::unique_lock<std::mutex> lock(cacheMutex);
+        auto it = entries.find(key);
+        if (it == entries.end()) return;
+        it->second.entry.time = std::time(nullptr);
+        entry                 = it->second.entry;
+    }
+    save(key, entry);
+}
+
+void ResponseCache::save(const std::string& key, const Entry& entry) {
+    if (CACHE_DIR.empty()) return;
+    nlohmann::json content = {
+        {"body", entry.body},
+        {"etag", entry.etag},
+        {"last_modified", entry.lastModified},
+        {"time", entry.time},
+    };
+
+    // 先写入临时文件再重命名，避免程序退出时留下不完整的缓存
+    // 同一个 key 可能同时在多个线程中写入，临时文件按线程区分
+    std::error_code ec;
+    std::filesystem::create_directories(CACHE_DIR, ec);
+    std::string path = getPath(key);
+    size_t thread    = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    std::string temp = path + "." + std::to_string(thread) + ".tmp";
+    std::string data = content.dump();
+    std::ofstream writeFile(temp);
+    if (!writeFile) {
+        printf("ResponseCache: cannot write to %s\n", temp.c_str());
+        return;
+    }
+    writeFile << data;
+    writeFile.close();
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(cacheMutex);
+    if (diskBytes == 0) {
+        this->trimDisk();
+    } else {
+        diskBytes += data.size();
+        if (diskBytes > CAPACITY) this->trimDisk();
+    }
+}
+
+void ResponseCache::trimDisk() {
+    struct File {
+        std::filesystem::path path;
+        std::filesystem::file_time_type time;
+        size_t size;
+    };
+    std::vector<File> files;
+    std::error_code ec;
+    diskBytes = 0;
+    for (auto& i : std::filesystem::directory_iterator(CACHE_DIR, ec)) {
+        if (!i.is_regular_file(ec)) continue;
+        // 其他线程正在写入的临时文件不计入
+        if (i.path().extension() != ".json") continue;
+        File file{i.path(), i.last_write_time(ec), (size_t)i.file_size(ec)};
+        files.push_back(file);
+        diskBytes += file.size;
+    }
+    if (diskBytes <= CAPACITY) return;
+
+    std::sort(files.begin(), files.end(), [](const File& a, const File& b) {
+        return a.time < b.time;
+    });
+    for (auto& i : files) {
+        if (diskBytes <= CAPACITY) break;
+        if (std::filesystem::remove(i.path, ec)) diskBytes -= i.size;
+    }
+}
+
+void ResponseCache::clear() {
+    std::unique_lock<std::mutex> lock(cacheMutex);
+    entries.clear();
+    order.clear();
+    diskBytes = 0;
+    if (CACHE_DIR.empty()) return;
+    std::error_code ec;
+    std::filesystem::remove_all(CACHE_DIR, ec);
+}
+
+}  // namespace bilibili
@@ -0,0 +1,145 @@
+#include <thread>
+#include <unordered_set>
+
+#include "bilibili/util/session_pool.hpp"
+#include "curl/curl.h"
+
+namespace bilibili {
+
+std::string SessionPool::getHostKey(const std::string& url, bool post) {
+    // https://api.bilibili.com/x/... => https://api.bilibili.com
+    size_t start     = url.find("://");
+    start            = start == std::string::npos ? 0 : start + 3;
+    size_t end       = url.find_first_of("/?#", start);
+    std::string host = url.substr(0, end);
+    return post ? "POST " + host : host;
+}
+
+static std::mutex shareMutex[CURL_LOCK_DATA_LAST];
+
+static void shareLock(CURL* handle, curl_lock_data data,
+                      curl_lock_access access, void* userptr) {
+    shareMutex[data].lock();
+}
+
+static void shareUnlock(CURL* handle, curl_lock_data data, void* userptr) {
+    shareMutex[data].unlock();
+}
+
+CURLSH* SessionPool::getShare() {
+    static CURLSH* share = []() {
+        CURLSH* res = curl_share_init();
+        curl_share_setopt(res, CURLSHOPT_LOCKFUNC, shareLock);
+        curl_share_setopt(res, CURLSHOPT_UNLOCKFUNC, shareUnlock);
+        curl_share_setopt(res, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(res, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        return res;
+    }();
+    return share;
+}
+
+cpr::Session* SessionPool::createSession() {
+    auto session = new cpr::Session();
+#ifndef VERIFY_SSL
+    session->SetVerifySsl(cpr::VerifySsl{false});
+#endif
+
+    CURL* handle = session->GetCurlHolder()->handle;
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_SHARE, getShare());
+    curl_easy_setopt(handle, CURLOPT_DNS_CACHE_TIMEOUT,
+                     (long)DNS_CACHE_TIMEOUT);
+#if LIBCURL_VERSION_NUM >= 0x074100
+    // 超过空闲时间的连接不再复用
+    curl_easy_setopt(handle, CURLOPT_MAXAGE_CONN, (long)IDLE_TIMEOUT);
+#endif
+
+    // 服务器支持时使用 HTTP/2
+    static bool supportHTTP2 =
+        curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2;
+    if (supportHTTP2) {
+        session->SetHttpVersion(
+            cpr::HttpVersion{cpr::HttpVersionCode::VERSION_2_0_TLS});
+    }
+    return session;
+}
+
+SessionPtr SessionPool::acquire(const std::string& url, bool post) {
+    if (!ENABLED) return SessionPtr(createSession());
+
+    std::string key       = getHostKey(url, post);
+    cpr::Session* session = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(poolMutex);
+        auto& host = hosts[key];
+        poolCondition.wait(lock, [&host]() {
+            return !host.idle.empty() ||
+                   host.inUse < MAX_CONNECTIONS_PER_HOST;
+        });
+
+        // 丢弃空闲时间过长的连接
+        auto now = std::chrono::steady_clock::now();
+        while (!host.idle.empty() &&
+               now - host.idle.back().since >
+                   std::chrono::seconds(IDLE_TIMEOUT)) {
+            delete host.idle.back().session;
+            host.idle.pop_back();
+        }
+
+        if (!host.idle.empty()) {
+            // 优先使用最近归还的连接
+            session = host.idle.front().session;
+            host.idle.pop_front();
+        }
+        host.inUse++;
+    }
+
+    if (!session) session = createSession();
+    return SessionPtr(session, [key](cpr::Session* s) {
+        SessionPool::instance().release(key, s);
+    });
+}
+
+void SessionPool::release(const std::string& key, cpr::Session* session) {
+    {
+        std::unique_lock<std::mutex> lock(poolMutex);
+        auto& host = hosts[key];
+        host.inUse--;
+        if (ENABLED) {
+            host.idle.push_front({session, std::chrono::steady_clock::now()});
+            session = nullptr;
+        }
+    }
+    delete session;
+    poolCondition.notify_all();
+}
+
+void SessionPool::warmUp(const std::vector<std::string>& urls) {
+    // 每个域名使用一个单独的短时线程，不占用 cpr::async 的线程池
+    // 否则启动时的接口请求要排在所有预连接之后
+    std::unordered_set<std::string> keys;
+    for (auto& url : urls) {
+        if (!keys.insert(getHostKey(url, false)).second) continue;
+        std::thread([url]() {
+            auto session = SessionPool::instance().acquire(url);
+            session->SetUrl(cpr::Url{url});
+            session->SetTimeout(cpr::Timeout{WARM_UP_TIMEOUT});
+            session->SetProgressCallback(cpr::ProgressCallback(
+                [](cpr::cpr_off_t downloadTotal, cpr::cpr_off_t downloadNow,
+                   cpr::cpr_off_t uploadTotal, cpr::cpr_off_t uploadNow,
+                   intptr_t userdata) -> bool { return true; }));
+            // 只需要建立连接，不关心返回的内容
+            session->Head();
+        }).detach();
+    }
+}
+
+void SessionPool::clear() {
+    std::unique_lock<std::mutex> lock(poolMutex);
+    for (auto& host : hosts) {
+        for (auto& i : host.second.idle) delete i.session;
+        host.second.idle.clear();
+    }
+}
+
+}  // namespace bilibili
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <unordered_map>
+
+#include "nlohmann/json.hpp"
+#include "bilibili/util/telemetry.hpp"
+
+namespace bilibili {
+
+static double getTime(CURL* handle, CURLINFO info) {
+    double value = 0;
+    curl_easy_getinfo(handle, info, &value);
+    return value * 1000;
+}
+
+static Telemetry::Percentile getPercentile(std::vector<double> values) {
+    Telemetry::Percentile res;
+    if (values.empty()) return res;
+    std::sort(values.begin(), values.end());
+    res.p50 = values[(values.size() - 1) / 2];
+    res.p95 = values[(values.size() * 95 + 99) / 100 - 1];
+    return res;
+}
+
+static nlohmann::json toJson(const Telemetry::Percentile& value) {
+    return {{"p50", value.p50}, {"p95", value.p95}};
+}
+
+Telemetry::Sample Telemetry::measure(const std::string& url,
+                                     cpr::Session& session,
+                                     const cpr::Response& response) {
+    Sample sample;
+    // 去掉协议与请求参数，部分接口把参数直接拼接在链接中
+    size_t start    = url.find("://");
+    start           = start == std::string::npos ? 0 : start + 3;
+    size_t end      = url.find_first_of("?#", start);
+    sample.endpoint = url.substr(start, end - start);
+    sample.status   = response.status_code;
+    sample.bytes    = response.downloaded_bytes;
+    sample.time     = std::time(nullptr);
+
+    // curl 记录的是从请求开始到各个阶段结束的累计时间
+    CURL* handle      = session.GetCurlHolder()->handle;
+    double nameLookup = getTime(handle, CURLINFO_NAMELOOKUP_TIME);
+    double connect    = getTime(handle, CURLINFO_CONNECT_TIME);
+    double appConnect = getTime(handle, CURLINFO_APPCONNECT_TIME);
+    sample.dns        = nameLookup;
+    sample.connect    = std::max(connect - nameLookup, 0.0);
+    sample.tls        = appConnect > 0 ? appConnect - connect : 0;
+    sample.ttfb       = getTime(handle, CURLINFO_STARTTRANSFER_TIME);
+    sample.total      = getTime(handle, CURLINFO_TOTAL_TIME);
+    return sample;
+}
+
+void Telemetry::record(const Sample& sample) {
+    if (!ENABLED || CAPACITY == 0) return;
+    std::unique_lock<std::mutex> lock(telemetryMutex);
+    if (samples.size() < CAPACITY) {
+        samples.push_back(sample);
+    } else {
+        samples[next % samples.size()] = sample;
+    }
+    next = (next + 1) % CAPACITY;
+}
+
+std::vector<Telemetry::Summary> Telemetry::summarize() {
+    std::unordered_map<std::string, std::vector<Sample>> endpoints;
+    {
+        std::unique_lock<std::mutex> lock(telemetryMutex);
+        for (auto& i : samples) endpoints[i.endpoint].push_back(i);
+    }
+
+    std::vector<Summary> res;
+    for (auto& endpoint : endpoints) {
+        auto& list = endpoint.second;
+        auto get   = [&list](const std::function<double(const Sample&)>& f) {
+            std::vector<double> values;
+            for (auto& i : list) values.push_back(f(i));
+            return getPercentile(values);
+        };
+
+        Summary summary;
+        summary.endpoint = endpoint.first;
+        summary.count    = list.size();
+        for (auto& i : list) {
+            summary.bytes += i.bytes;
+            summary.status[i.status]++;
+        }
+        summary.dns     = get([](const Sample& i) { return i.dns; });
+        summary.connect = get([](const Sample& i) { return i.connect; });
+        summary.tls     = get([](const Sample& i) { return i.tls; });
+        summary.ttfb    = get([](const Sample& i) { return i.ttfb; });
+        summary.total   = get([](const Sample& i) { return i.total; });
+        summary.parse   = get([](const Sample& i) { return i.parse; });
+        res.emplace_back(std::move(summary));
+    }
+    std::sort(res.begin(), res.end(), [](const Summary& a, const Summary& b) {
+        return a.count > b.count;
+    });
+    return res;
+}
+
+bool Telemetry::save(const std::string& path) {
+    nlohmann::json endpoints = nlohmann::json::array();
+    for (auto& i : summarize()) {
+        nlohmann::json status;
+        for (auto& s : i.status) status[std::to_string(s.first)] = s.second;
+        endpoints.push_back({
+            {"endpoint", i.endpoint},
+            {"count", i.count},
+            {"bytes", i.bytes},
+            {"status", status},
+            {"dns", toJson(i.dns)},
+            {"connect", toJson(i.connect)},
+            {"tls", toJson(i.tls)},
+            {"ttfb", toJson(i.ttfb)},
+            {"total", toJson(i.total)},
+            {"parse", toJson(i.parse)},
+        });
+    }
+
+    nlohmann::json list = nlohmann::json::array();
+    {
+        std::unique_lock<std::mutex> lock(telemetryMutex);
+        for (auto& i : samples) {
+            list.push_back({
+                {"endpoint", i.endpoint},
+                {"status", i.status},
+                {"dns", i.dns},
+                {"connect", i.connect},
+                {"tls", i.tls},
+                {"ttfb", i.ttfb},
+                {"total", i.total},
+                {"parse", i.parse},
+                {"bytes", i.bytes},
+                {"time", i.time},
+            });
+        }
+    }
+
+    std::ofstream writeFile(path);
+    if (!writeFile) {
+        printf("Telemetry: cannot write to %s\n", path.c_str());
+        return false;
+    }
+    nlohmann::json content = {
+        {"time", std::time(nullptr)},
+        {"endpoints", endpoints},
+        {"samples", list},
+    };
+    writeFile << content.dump(2);
+    return true;
+}
+
+void Telemetry::clear() {
+    std::unique_lock<std::mutex> lock(telemetryMutex);
+    samples.clear();
+    next = 0;
+}
+
+}  // namespace bilibili
@@ -8,78 +8,78 @@
 
 namespace bilibili {
 
-void BilibiliClient::get_video_detail(
+CancelHandle BilibiliClient::get_video_detail(
     const std::string& bvid,
     const std::function<void(VideoDetailResult)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoDetailResult>(Api::Detail, {{"bvid", bvid}},
-                                            callback, error);
+    return HTTP::getResultAsync<VideoDetailResult>(
+        Api::Detail, {{"bvid", bvid}}, callback, error);
 }
 
-void BilibiliClient::get_video_detail(
+CancelHandle BilibiliClient::get_video_detail(
     const int aid, const std::function<void(VideoDetailResult)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoDetailResult>(
+    return HTTP::getResultAsync<VideoDetailResult>(
         Api::Detail, {{"aid", std::to_string(aid)}}, callback, error);
 }
 
-void BilibiliClient::get_video_detail_all(
+CancelHandle BilibiliClient::get_video_detail_all(
     const std::string& bvid,
     const std::function<void(VideoDetailAllResult)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoDetailAllResult>(Api::DetailAll, {{"bvid", bvid}},
-                                               callback, error);
+    return HTTP::getResultAsync<VideoDetailAllResult>(
+        Api::DetailAll, {{"bvid", bvid}}, callback, error);
 }
 
-void BilibiliClient::get_video_pagelist(
+CancelHandle BilibiliClient::get_video_pagelist(
     const std::string& bvid,
     const std::function<void(VideoDetailPageListResult Result)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoDetailPageListResult>(
+    return HTTP::getResultAsync<VideoDetailPageListResult>(
         Api::PlayPageList, {{"bvid", std::string(bvid)}}, callback, error);
 }
 
-void BilibiliClient::get_video_pagelist(
+CancelHandle BilibiliClient::get_video_pagelist(
     const int aid,
     const std::function<void(VideoDetailPageListResult)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoDetailPageListResult>(
+    return HTTP::getResultAsync<VideoDetailPageListResult>(
         Api::PlayPageList, {{"aid", std::to_string(aid)}}, callback, error);
 }
 
-void BilibiliClient::get_video_url(
+CancelHandle BilibiliClient::get_video_url(
     const std::string& bvid, const int cid, const int qn,
     const std::function<void(VideoUrlResult)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoUrlResult>(Api::PlayInformation,
-                                         {{"bvid", std::string(bvid)},
-                                          {"cid", std::to_string(cid)},
-                                          {"qn", std::to_string(qn)},
-                                          {"fourk", "1"},
-                                          {"fnval", "16"},
-                                          {"fnver", "0"}},
-                                         callback, error);
+    return HTTP::getResultAsync<VideoUrlResult>(Api::PlayInformation,
+                                                {{"bvid", std::string(bvid)},
+                                                 {"cid", std::to_string(cid)},
+                                                 {"qn", std::to_string(qn)},
+                                                 {"fourk", "1"},
+                                                 {"fnval", "16"},
+                                                 {"fnver", "0"}},
+                                                callback, error);
 }
 
-void BilibiliClient::get_video_url(
+CancelHandle BilibiliClient::get_video_url(
     const int aid, const int cid, const int qn,
     const std::function<void(VideoUrlResult)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoUrlResult>(Api::PlayInformation,
-                                         {{"aid", std::to_string(aid)},
-                                          {"cid", std::to_string(cid)},
-                                          {"qn", std::to_string(qn)},
-                                          {"fourk", "1"},
-                                          {"fnval", "16"},
-                                          {"fnver", "0"}},
-                                         callback, error);
+    return HTTP::getResultAsync<VideoUrlResult>(Api::PlayInformation,
+                                                {{"aid", std::to_string(aid)},
+                                                 {"cid", std::to_string(cid)},
+                                                 {"qn", std::to_string(qn)},
+                                                 {"fourk", "1"},
+                                                 {"fnval", "16"},
+                                                 {"fnver", "0"}},
+                                                callback, error);
 }
 
-void BilibiliClient::get_comment(
+CancelHandle BilibiliClient::get_comment(
     int aid, int next, int mode,
     const std::function<void(VideoCommentResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoCommentResultWrapper>(
+    return HTTP::getResultAsync<VideoCommentResultWrapper>(
         Api::Comment,
         {{"mode", std::to_string(mode)},
          {"next", std::to_string(next)},
@@ -89,7 +89,7 @@ void BilibiliClient::get_comment(
         callback, error);
 }
 
-void BilibiliClient::get_season_detail(
+CancelHandle BilibiliClient::get_season_detail(
     const int seasonID, const int epID,
     const std::function<void(SeasonResultWrapper)>& callback,
     const ErrorCallback& error) {
@@ -100,71 +100,75 @@ void BilibiliClient::get_season_detail(
         params = {{"ep_id", std::to_string(epID)}};
     }
 
-    HTTP::getResultAsync<SeasonResultWrapper>(Api::SeasonDetail, params,
-                                              callback, error);
+    return HTTP::getResultAsync<SeasonResultWrapper>(Api::SeasonDetail,
+                                                     params, callback, error);
 }
 
-void BilibiliClient::get_season_url(
+CancelHandle BilibiliClient::get_season_url(
     const int cid, const int qn,
     const std::function<void(VideoUrlResult)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoUrlResult>(Api::SeasonUrl,
-                                         {{"cid", std::to_string(cid)},
-                                          {"qn", std::to_string(qn)},
-                                          {"fourk", "1"},
-                                          {"fnval", "16"},
-                                          {"fnver", "0"}},
-                                         callback, error);
+    return HTTP::getResultAsync<VideoUrlResult>(Api::SeasonUrl,
+                                                {{"cid", std::to_string(cid)},
+                                                 {"qn", std::to_string(qn)},
+                                                 {"fourk", "1"},
+                                                 {"fnval", "16"},
+                                                 {"fnver", "0"}},
+                                                callback, error);
 }
 
-void BilibiliClient::get_live_url(
+CancelHandle BilibiliClient::get_live_url(
     const int roomid, const int qn,
     const std::function<void(LiveUrlResultWrapper)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<LiveUrlResultWrapper>(Api::LiveUrl,
-                                               {{"cid", std::to_string(roomid)},
-                                                {"platform", "web"},
-                                                {"qn", std::to_string(qn)}},
-                                               callback, error);
+    return HTTP::getResultAsync<LiveUrlResultWrapper>(
+        Api::LiveUrl,
+        {{"cid", std::to_string(roomid)},
+         {"platform", "web"},
+         {"qn", std::to_string(qn)}},
+        callback, error);
 }
 
 /// 视频页 获取单个视频播放人数
-void BilibiliClient::get_video_online(
+CancelHandle BilibiliClient::get_video_online(
     int aid, int cid, const std::function<void(VideoOnlineTotal)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoOnlineTotal>(Api::OnlineViewerCount,
-                                           {
-                                               {"cid", std::to_string(cid)},
-                                               {"aid", std::to_string(aid)},
-                                           },
-                                           callback, error);
+    return HTTP::getResultAsync<VideoOnlineTotal>(
+        Api::OnlineViewerCount,
+        {
+            {"cid", std::to_string(cid)},
+            {"aid", std::to_string(aid)},
+        },
+        callback, error);
 }
 
-void BilibiliClient::get_video_online(
+CancelHandle BilibiliClient::get_video_online(
     const std::string& bvid, int cid,
     const std::function<void(VideoOnlineTotal)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoOnlineTotal>(Api::OnlineViewerCount,
-                                           {
-                                               {"cid", std::to_string(cid)},
-                                               {"bvid", bvid},
-                                           },
-                                           callback, error);
+    return HTTP::getResultAsync<VideoOnlineTotal>(
+        Api::OnlineViewerCount,
+        {
+            {"cid", std::to_string(cid)},
+            {"bvid", bvid},
+        },
+        callback, error);
 }
 
 /// 视频页 获取点赞/收藏/投屏情况
-void BilibiliClient::get_video_relation(
+CancelHandle BilibiliClient::get_video_relation(
     const std::string& bvid, const std::function<void(VideoRelation)>& callback,
     const ErrorCallback& error) {
-    HTTP::getResultAsync<VideoRelation>(Api::VideoRelation, {{"bvid", bvid}},
-                                        callback, error);
+    return HTTP::getResultAsync<VideoRelation>(
+        Api::VideoRelation, {{"bvid", bvid}}, callback, error);
 }
 
-void BilibiliClient::get_danmaku(
+CancelHandle BilibiliClient::get_danmaku(
     const unsigned int cid, const std::function<void(std::string)>& callback,
     const ErrorCallback& error) {
-    cpr::GetCallback<>(
-        [callback, error](cpr::Response r) {
+    return HTTP::__cpr_get(
+        Api::VideoDanmaku, {{"oid", std::to_string(cid)}},
+        [callback, error](const cpr::Response& r) {
             try {
                 callback(r.text);
             } catch (const std::exception& e) {
@@ -174,23 +178,15 @@ void BilibiliClient::get_danmaku(
                 printf("data: %s\n", r.text.c_str());
                 printf("ERROR: %s\n", e.what());
             }
-        },
-#ifndef VERIFY_SSL
-        cpr::VerifySsl{false},
-#endif
-        cpr::Url{Api::VideoDanmaku}, HTTP::HEADERS,
-        cpr::Parameters({{"oid", std::to_string(cid)}}), HTTP::COOKIES,
-        cpr::Timeout{HTTP::TIMEOUT});
+        });
 }
 
 /// 视频页 上报历史记录
-void BilibiliClient::report_history(const std::string& mid,
-                                    const std::string& access_key,
-                                    unsigned int aid, unsigned int cid,
-                                    int type, unsigned int progress,
-                                    unsigned int sid, unsigned int epid,
-                                    const std::function<void()>& callback,
-                                    const ErrorCallback& error) {
+CancelHandle BilibiliClient::report_history(
+    const std::string& mid, const std::string& access_key, unsigned int aid,
+    unsigned int cid, int type, unsigned int progress, unsigned int sid,
+    unsigned int epid, const std::function<void()>& callback,
+    const ErrorCallback& error) {
     cpr::Payload payload = {
         {"mid", mid},
         {"access_key", access_key},
@@ -205,70 +201,73 @@ void BilibiliClient::report_history(const std::string& mid,
         if (epid != 0) payload.Add({"epid", std::to_string(epid)});
     }
 
-    HTTP::__cpr_post(Api::ProgressReport, {}, payload,
-                     [callback, error](const cpr::Response& r) {
-                         if (r.status_code != 200) {
-                             ERROR_MSG("ERROOR: report_history: status_code: " +
-                                           std::to_string(r.status_code),
-                                       r.status_code);
-                         } else {
-                             callback();
-                         }
-                     });
+    return HTTP::__cpr_post(
+        Api::ProgressReport, {}, payload,
+        [callback, error](const cpr::Response& r) {
+            if (r.status_code != 200) {
+                ERROR_MSG("ERROOR: report_history: status_code: " +
+                              std::to_string(r.status_code),
+                          r.status_code);
+            } else {
+                callback();
+            }
+        });
 }
-void BilibiliClient::be_agree(const std::string& access_key, int aid,
-                              bool is_like,
-                              const std::function<void()>& callback,
-                              const ErrorCallback& error) {
+CancelHandle BilibiliClient::be_agree(const std::string& access_key, int aid,
+                                      bool is_like,
+                                      const std::function<void()>& callback,
+                                      const ErrorCallback& error) {
     cpr::Payload payload = {
         {"aid", std::to_string(aid)},
         {"like", std::to_string(is_like)},
         {"csrf", access_key},
     };
-    HTTP::__cpr_post("http://api.bilibili.com/x/web-interface/archive/like", {},
-                     payload, [callback, error](const cpr::Response& r) {
-                         if (r.status_code != 200) {
-                             ERROR_MSG("ERROOR: report_history: status_code: " +
-                                           std::to_string(r.status_code),
-                                       r.status_code);
-                         } else {
-                             callback();
-                         }
-                     });
+    return HTTP::__cpr_post(
+        "http://api.bilibili.com/x/web-interface/archive/like", {}, payload,
+        [callback, error](const cpr::Response& r) {
+            if (r.status_code != 200) {
+                ERROR_MSG("ERROOR: report_history: status_code: " +
+                              std::to_string(r.status_code),
+                          r.status_code);
+            } else {
+                callback();
+            }
+        });
 }
 
-void BilibiliClient::add_coin(const std::string& access_key, int aid,
-                              unsigned int coin_number, bool is_like,
-                              const std::function<void()>& callback,
-                              const ErrorCallback& error) {
+CancelHandle BilibiliClient::add_coin(const std::string& access_key, int aid,
+                                      unsigned int coin_number, bool is_like,
+                                      const std::function<void()>& callback,
+                                      const ErrorCallback& error) {
     cpr::Payload payload = {
         {"aid", std::to_string(aid)},
         {"select_like", std::to_string(is_like)},
         {"multiply", std::to_string(coin_number)},
         {"csrf", access_key},
     };
-    HTTP::__cpr_post("http://api.bilibili.com/x/web-interface/coin/add", {},
-                     payload, [callback, error](const cpr::Response& r) {
-                         if (r.status_code != 200) {
-                             ERROR_MSG("ERROOR: report_history: status_code: " +
-                                           std::to_string(r.status_code),
-                                       r.status_code);
-                         } else {
-                             callback();
-                         }
-                     });
+    return HTTP::__cpr_post(
+        "http://api.bilibili.com/x/web-interface/coin/add", {}, payload,
+        [callback, error](const cpr::Response& r) {
+            if (r.status_code != 200) {
+                ERROR_MSG("ERROOR: report_history: status_code: " +
+                              std::to_string(r.status_code),
+                          r.status_code);
+            } else {
+                callback();
+            }
+        });
 }
 
-void BilibiliClient::add_resource(const std::string& access_key, int aid,
-                                  const std::function<void()>& callback,
-                                  const ErrorCallback& error) {
+CancelHandle BilibiliClient::add_resource(
+    const std::string& access_key, int aid,
+    const std::function<void()>& callback, const ErrorCallback& error) {
     cpr::Payload payload = {
         {"rid", std::to_string(aid)},
         {"type", std::to_string(2)},
         {"add_media_ids", std::to_string(1)},
         {"csrf", access_key},
     };
-    HTTP::__cpr_post(
+    return HTTP::__cpr_post(
         "http://api.bilibili.com/medialist/gateway/coll/resource/deal", {},
         payload, [callback, error](const cpr::Response& r) {
             if (r.status_code != 200) {
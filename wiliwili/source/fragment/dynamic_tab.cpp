@@ -14,6 +14,8 @@ class DynamicUserInfoView : public RecyclingGridItem {
 public:
     DynamicUserInfoView(std::string xml) { this->inflateFromXMLRes(xml); }
 
+    ~DynamicUserInfoView() { this->cacheForReuse(); }
+
     void setUserInfo(std::string avatar, std::string username,
                      bool isUpdate = false) {
         this->labelUsername->setText(username);
@@ -55,8 +57,11 @@ public:
             (DynamicUserInfoView*)recycler->dequeueReusableCell("Cell");
 
         auto& r = this->list[index - 1];
-        item->setUserInfo(r.user_profile.info.face + "@96w_96h_1c.jpg",
-                          r.user_profile.info.uname);
+        item->setUserInfo(
+            ImageHelper::thumbnail(r.user_profile.info.face,
+                                   item->getAvatar()->getWidth(),
+                                   ThumbnailType::AVATAR),
+            r.user_profile.info.uname);
         return item;
     }
 
@@ -96,13 +101,23 @@ public:
             (RecyclingGridItemVideoCard*)recycler->dequeueReusableCell("Cell");
 
         auto& r = this->list[index];
-        item->setCard(r.pic + "@672w_378h_1c.jpg", r.title, r.owner.name,
-                      r.pubdate, r.stat.view, r.stat.danmaku, r.duration);
+        item->setCard(ImageHelper::thumbnail(r.pic, recycler->getItemWidth()),
+                      r.title, r.owner.name, r.pubdate, r.stat.view,
+                      r.stat.danmaku, r.duration);
         return item;
     }
 
     size_t getItemCount() override { return list.size(); }
 
+    std::vector<std::string> getImageUrls(RecyclingGrid* recycler, size_t start,
+                                          size_t end) override {
+        std::vector<std::string> urls;
+        for (size_t i = start; i < end; i++)
+            urls.push_back(ImageHelper::thumbnail(this->list[i].pic,
+                                                  recycler->getItemWidth()));
+        return urls;
+    }
+
     void onItemSelected(RecyclingGrid* recycler, size_t index) override {
         brls::Application::pushActivity(new PlayerActivity(list[index].bvid));
     }
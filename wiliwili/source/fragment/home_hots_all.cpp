@@ -6,6 +6,7 @@
 #include "fragment/home_hots_all.hpp"
 #include "view/video_card.hpp"
 #include "view/recycling_grid.hpp"
+#include "utils/image_helper.hpp"
 
 class DataSourceHotsAllVideoList : public RecyclingGridDataSource {
 public:
@@ -19,13 +20,23 @@ public:
 
         bilibili::HotsAllVideoResult& r = this->videoList[index];
         brls::Logger::debug("title: {}", r.title);
-        item->setCard(r.pic + "@672w_378h_1c.jpg", r.title, r.owner.name,
-                      r.pubdate, r.stat.view, r.stat.danmaku, r.duration);
+        item->setCard(ImageHelper::thumbnail(r.pic, recycler->getItemWidth()),
+                      r.title, r.owner.name, r.pubdate, r.stat.view,
+                      r.stat.danmaku, r.duration);
         return item;
     }
 
     size_t getItemCount() override { return videoList.size(); }
 
+    std::vector<std::string> getImageUrls(RecyclingGrid* recycler, size_t start,
+                                          size_t end) override {
+        std::vector<std::string> urls;
+        for (size_t i = start; i < end; i++)
+            urls.push_back(ImageHelper::thumbnail(this->videoList[i].pic,
+                                                  recycler->getItemWidth()));
+        return urls;
+    }
+
     void onItemSelected(RecyclingGrid* recycler, size_t index) override {
         brls::Application::pushActivity(
             new PlayerActivity(videoList[index].bvid));
@@ -8,6 +8,7 @@
 #include "view/recycling_grid.hpp"
 #include "view/video_card.hpp"
 #include "view/grid_dropdown.hpp"
+#include "utils/image_helper.hpp"
 
 class DataSourceHotsRankVideoList : public RecyclingGridDataSource {
 public:
@@ -22,14 +23,23 @@ public:
 
         auto r = this->videoList[index];
         brls::Logger::debug("title: {}", r.title);
-        item->setCard(r.pic + "@672w_378h_1c.jpg", r.title, r.owner.name,
-                      r.pubdate, r.stat.view, r.stat.danmaku, r.duration,
-                      index + 1);
+        item->setCard(ImageHelper::thumbnail(r.pic, recycler->getItemWidth()),
+                      r.title, r.owner.name, r.pubdate, r.stat.view,
+                      r.stat.danmaku, r.duration, index + 1);
         return item;
     }
 
     size_t getItemCount() override { return videoList.size(); }
 
+    std::vector<std::string> getImageUrls(RecyclingGrid* recycler, size_t start,
+                                          size_t end) override {
+        std::vector<std::string> urls;
+        for (size_t i = start; i < end; i++)
+            urls.push_back(ImageHelper::thumbnail(this->videoList[i].pic,
+                                                  recycler->getItemWidth()));
+        return urls;
+    }
+
     void onItemSelected(RecyclingGrid* recycler, size_t index) override {
         brls::Application::pushActivity(
             new PlayerActivity(videoList[index].bvid));
@@ -60,14 +70,25 @@ public:
 
         auto r = this->videoList[index];
         brls::Logger::debug("title: {}", r.title);
-        item->setCard(r.ss_horizontal_cover + "@672w_378h_1c.jpg", r.title,
-                      r.new_ep.index_show, 0, r.stat.view, r.stat.danmaku, 0,
-                      index + 1);
+        auto cover = ImageHelper::thumbnail(r.ss_horizontal_cover,
+                                            recycler->getItemWidth());
+        item->setCard(cover, r.title, r.new_ep.index_show, 0, r.stat.view,
+                      r.stat.danmaku, 0, index + 1);
         return item;
     }
 
     size_t getItemCount() override { return videoList.size(); }
 
+    std::vector<std::string> getImageUrls(RecyclingGrid* recycler, size_t start,
+                                          size_t end) override {
+        std::vector<std::string> urls;
+        for (size_t i = start; i < end; i++)
+            urls.push_back(ImageHelper::thumbnail(
+                this->videoList[i].ss_horizontal_cover,
+                recycler->getItemWidth()));
+        return urls;
+    }
+
     void onItemSelected(RecyclingGrid* recycler, size_t index) override {
         brls::Application::pushActivity(
             new PlayerSeasonActivity(videoList[index].season_id));
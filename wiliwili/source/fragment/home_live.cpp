@@ -7,6 +7,7 @@
 #include "view/recycling_grid.hpp"
 #include "view/video_card.hpp"
 #include "activity/live_player_activity.hpp"
+#include "utils/image_helper.hpp"
 
 using namespace brls::literals;
 
@@ -22,13 +23,22 @@ public:
                 "Cell");
 
         bilibili::LiveVideoResult& r = this->videoList[index];
-        item->setCard(r.cover + "@672w_378h_1c.jpg", r.title, r.uname,
-                      r.area_name, r.online, r.following);
+        item->setCard(ImageHelper::thumbnail(r.cover, recycler->getItemWidth()),
+                      r.title, r.uname, r.area_name, r.online, r.following);
         return item;
     }
 
     size_t getItemCount() override { return videoList.size(); }
 
+    std::vector<std::string> getImageUrls(RecyclingGrid* recycler, size_t start,
+                                          size_t end) override {
+        std::vector<std::string> urls;
+        for (size_t i = start; i < end; i++)
+            urls.push_back(ImageHelper::thumbnail(this->videoList[i].cover,
+                                                  recycler->getItemWidth()));
+        return urls;
+    }
+
     void onItemSelected(RecyclingGrid* recycler, size_t index) override {
         brls::Application::pushActivity(new LiveActivity(videoList[index]));
     }
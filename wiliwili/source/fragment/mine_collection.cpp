@@ -6,6 +6,7 @@
 #include "fragment/mine_collection_video_list.hpp"
 #include "view/video_card.hpp"
 #include "utils/number_helper.hpp"
+#include "utils/image_helper.hpp"
 
 using namespace brls::literals;
 
@@ -30,10 +31,7 @@ public:
         }
         auto time = "wiliwili/mine/pub"_i18n + wiliwili::sec2date(r.ctime);
 
-        auto cover = r.cover;
-        if (!cover.empty()) {
-            cover += "@672w_378h_1c.jpg";
-        }
+        auto cover = ImageHelper::thumbnail(r.cover, recycler->getItemWidth());
         item->setCard(cover, r.title, time, badge);
 
         return item;
@@ -23,8 +23,9 @@ public:
         std::string author = r.upper.name;
         if (r.type == 24) author = r.intro;
 
-        item->setCard(r.cover + "@672w_378h_1c.jpg", r.title, author, r.pubtime,
-                      r.cnt_info.play, r.cnt_info.danmaku, r.duration);
+        item->setCard(ImageHelper::thumbnail(r.cover, recycler->getItemWidth()),
+                      r.title, author, r.pubtime, r.cnt_info.play,
+                      r.cnt_info.danmaku, r.duration);
         return item;
     }
 
@@ -96,6 +97,7 @@ MineCollectionVideoList::MineCollectionVideoList(
 
 MineCollectionVideoList::~MineCollectionVideoList() {
     brls::Logger::debug("Fragment MineCollectionVideoListActivity: delete");
+    ImageHelper::clear(this->imageCover);
 }
 
 brls::View* MineCollectionVideoList::create(
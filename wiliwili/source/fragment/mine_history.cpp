@@ -7,6 +7,7 @@
 #include "activity/player_activity.hpp"
 #include "activity/live_player_activity.hpp"
 #include "utils/number_helper.hpp"
+#include "utils/image_helper.hpp"
 
 using namespace brls::literals;
 
@@ -47,8 +48,9 @@ public:
             progress = 1.0;
         }
 
-        item->setCard(r.cover + "@672w_378h_1c.jpg", r.title, author, time,
-                      duration, badge, r.history.dt, progress, showUpName);
+        item->setCard(ImageHelper::thumbnail(r.cover, recycler->getItemWidth()),
+                      r.title, author, time, duration, badge, r.history.dt,
+                      progress, showUpName);
 
         return item;
     }
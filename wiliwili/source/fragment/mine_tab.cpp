@@ -87,7 +87,10 @@ void MineTab::onCreate() {
         true);
 }
 
-MineTab::~MineTab() { brls::Logger::debug("Fragment MineTabActivity: delete"); }
+MineTab::~MineTab() {
+    brls::Logger::debug("Fragment MineTabActivity: delete");
+    ImageHelper::clear(this->imageUserAvater);
+}
 
 void MineTab::onUserNotLogin() {
     boxGotoUserSpace->registerAction(
@@ -104,6 +107,9 @@ void MineTab::onUserNotLogin() {
     brls::sync([ASYNC_TOKEN]() {
         ASYNC_RELEASE
         labelUserName->setText("wiliwili/mine/login/click"_i18n);
+        // 退出登录前的头像来自纹理缓存
+        ImageHelper::clear(imageUserAvater);
+        imageUserAvater->setFreeTexture(true);
         imageUserAvater->setImageFromRes("pictures/default_avatar.png");
         labelSign->setText("");
         labelCoins->setText("0");
@@ -9,6 +9,7 @@
 #include "activity/player_activity.hpp"
 #include "activity/search_activity.hpp"
 #include "fragment/search_tab.hpp"
+#include "presenter/presenter.h"
 
 SearchBangumi::SearchBangumi() {
     this->inflateFromXMLRes("xml/fragment/search_bangumi.xml");
@@ -29,12 +30,13 @@ brls::View* SearchBangumi::create() { return new SearchBangumi(); }
 void SearchBangumi::requestSearch(const std::string& key) {
     this->recyclingGrid->showSkeleton();
     this->requestIndex = 1;
+    this->requests.cancel();
     this->_requestSearch(key);
 }
 
 void SearchBangumi::_requestSearch(const std::string& key) {
     ASYNC_RETAIN
-    bilibili::BilibiliClient::search_video(
+    ASYNC_REQUEST(bilibili::BilibiliClient::search_video(
         key, "media_bangumi", requestIndex, "",
         [ASYNC_TOKEN](const bilibili::SearchResult& result) {
             for (auto i : result.result) {
@@ -73,5 +75,5 @@ void SearchBangumi::_requestSearch(const std::string& key) {
                 ASYNC_RELEASE
                 this->recyclingGrid->setError(error);
             });
-        });
+        }));
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "view/hots_card.hpp"
 #include "bilibili.h"
 #include "bilibili/result/search_result.h"
+#include "presenter/presenter.h"
 
 SearchHots::SearchHots() {
     this->inflateFromXMLRes("xml/fragment/search_hots.xml");
@@ -59,7 +60,7 @@ private:
 
 void SearchHots::requestSearch() {
     ASYNC_RETAIN
-    bilibili::BilibiliClient::get_search_hots(
+    ASYNC_REQUEST(bilibili::BilibiliClient::get_search_hots(
         50,
         [ASYNC_TOKEN](const bilibili::SearchHotsResultWrapper &result) {
             brls::Threading::sync([ASYNC_TOKEN, result]() {
@@ -75,5 +76,5 @@ void SearchHots::requestSearch() {
                 ASYNC_RELEASE
                 this->recyclingGrid->setError(error);
             });
-        });
+        }));
 }
@@ -9,6 +9,7 @@
 #include "activity/player_activity.hpp"
 #include "activity/search_activity.hpp"
 #include "fragment/search_tab.hpp"
+#include "presenter/presenter.h"
 
 SearchVideo::SearchVideo() {
     this->inflateFromXMLRes("xml/fragment/search_video.xml");
@@ -29,12 +30,13 @@ brls::View* SearchVideo::create() { return new SearchVideo(); }
 void SearchVideo::requestSearch(const std::string& key) {
     this->recyclingGrid->showSkeleton();
     this->requestIndex = 1;
+    this->requests.cancel();
     this->_requestSearch(key);
 }
 
 void SearchVideo::_requestSearch(const std::string& key) {
     ASYNC_RETAIN
-    bilibili::BilibiliClient::search_video(
+    ASYNC_REQUEST(bilibili::BilibiliClient::search_video(
         key, "video", requestIndex, "",
         [ASYNC_TOKEN](const bilibili::SearchResult& result) {
             for (auto i : result.result) {
@@ -73,5 +75,5 @@ void SearchVideo::_requestSearch(const std::string& key) {
                 ASYNC_RELEASE
                 this->recyclingGrid->setError(error);
             });
-        });
+        }));
 }
\ No newline at end of file
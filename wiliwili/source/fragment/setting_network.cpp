@@ -2,12 +2,17 @@
 // Created by fang on 2022/9/19.
 //
 
+#include <pystring.h>
+#include "fmt/format.h"
 #include "fragment/setting_network.hpp"
 #include "bilibili.h"
 #include "bilibili/result/home_result.h"
 #include "bilibili/result/setting.h"
+#include "bilibili/util/telemetry.hpp"
 #include "utils/number_helper.hpp"
 #include "utils/config_helper.hpp"
+#include "utils/image_helper.hpp"
+#include "utils/texture_atlas.hpp"
 
 using namespace brls::literals;
 
@@ -16,6 +21,8 @@ SettingNetwork::SettingNetwork() {
     brls::Logger::debug("Fragment SettingNetwork: create");
     this->networkTest();
     this->getUnixTime();
+    this->showTelemetry();
+    this->showImageStats();
 
     if (brls::Application::getPlatform()->hasWirelessConnection()) {
         labelWIFI->setTextColor(nvgRGB(72, 154, 83));
@@ -73,6 +80,86 @@ void SettingNetwork::getUnixTime() {
         });
 }
 
+/// 中位数 / 95 分位数
+static std::string formatPercentile(const std::string& name,
+                                    const bilibili::Telemetry::Percentile& p) {
+    return fmt::format("{} {:.0f}/{:.0f}", name, p.p50, p.p95);
+}
+
+void SettingNetwork::showTelemetry() {
+    this->labelCoalesced->setText(
+        fmt::format("{} / {}", bilibili::HTTP::REQUEST_COALESCED.load(),
+                    bilibili::HTTP::REQUEST_TOTAL.load()));
+    this->labelCancelled->setText(fmt::format(
+        "{} ({:.1f} KB)", bilibili::CancelToken::CANCELLED_REQUESTS.load(),
+        bilibili::CancelToken::CANCELLED_BYTES.load() / 1024.0));
+
+    // 只展示请求次数最多的几个接口，完整的数据可以导出查看
+    const size_t maxRows = 6;
+    auto summaries       = bilibili::Telemetry::instance().summarize();
+    if (summaries.empty()) return;
+    this->labelTelemetryEmpty->setVisibility(brls::Visibility::GONE);
+
+    for (size_t i = 0; i < summaries.size() && i < maxRows; i++) {
+        auto& summary = summaries[i];
+        std::vector<std::string> status;
+        for (auto& s : summary.status)
+            status.emplace_back(fmt::format("{}x{}", s.first, s.second));
+
+        auto title = new brls::Label();
+        title->setFontSize(18);
+        title->setText(fmt::format("{}  ({} {}, {:.1f}KB)", summary.endpoint,
+                                   summary.count,
+                                   "wiliwili/setting/net/telemetry/count"_i18n,
+                                   summary.bytes / 1024.0));
+
+        auto detail = new brls::Label();
+        detail->setFontSize(14);
+        detail->setMarginBottom(10);
+        detail->setTextColor(nvgRGB(148, 153, 160));
+        detail->setText(pystring::join(
+            "  ",
+            {formatPercentile("DNS", summary.dns),
+             formatPercentile("wiliwili/setting/net/telemetry/connect"_i18n,
+                              summary.connect),
+             formatPercentile("TLS", summary.tls),
+             formatPercentile("wiliwili/setting/net/telemetry/ttfb"_i18n,
+                              summary.ttfb),
+             formatPercentile("wiliwili/setting/net/telemetry/total"_i18n,
+                              summary.total),
+             formatPercentile("wiliwili/setting/net/telemetry/parse"_i18n,
+                              summary.parse),
+             pystring::join(" ", status)}));
+
+        this->boxTelemetry->addView(title);
+        this->boxTelemetry->addView(detail);
+    }
+}
+
+void SettingNetwork::showImageStats() {
+    auto& atlas = TextureAtlas::instance().getStats();
+    this->labelAtlas->setText(
+        fmt::format("{} / {}", atlas.images, atlas.standalone));
+    this->labelAtlasUpload->setText(fmt::format(
+        "{} / {:.1f} KB", atlas.bindsSaved, atlas.uploadBytes / 1024.0));
+    auto& upload = ImageHelper::getUploadStats();
+    this->labelUpload->setText(fmt::format("{} / {}", upload.maxFrameUploads,
+                                           upload.totalDeferred));
+}
+
+void SettingNetwork::exportTelemetry() {
+    std::string path =
+        ProgramConfig::instance().getConfigDir() + "/network_telemetry.json";
+    std::string msg = "wiliwili/setting/net/telemetry/export_failed"_i18n;
+    if (bilibili::Telemetry::instance().save(path))
+        msg = "wiliwili/setting/net/telemetry/export_done"_i18n + path;
+    brls::sync([msg]() {
+        auto dialog = new brls::Dialog(msg);
+        dialog->addButton("hints/ok"_i18n, []() {});
+        dialog->open();
+    });
+}
+
 SettingNetwork::~SettingNetwork() {
     brls::Logger::debug("Fragment SettingNetwork: delete");
 }
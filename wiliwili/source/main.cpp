@@ -9,7 +9,11 @@
 #include "analytics.h"
 
 #include "utils/config_helper.hpp"
+#include "utils/image_disk_cache.hpp"
+#include "utils/network_admission.hpp"
 #include "utils/thread_helper.hpp"
+#include "bilibili/api.h"
+#include "bilibili/util/session_pool.hpp"
 #include "activity/main_activity.hpp"
 #include "activity/hint_activity.hpp"
 //#include "activity/setting_activity.hpp"
@@ -29,6 +33,18 @@ int main(int argc, char* argv[]) {
     cpr::async::startup(THREAD_POOL_MIN_THREAD_NUM, THREAD_POOL_MAX_THREAD_NUM,
                         std::chrono::milliseconds(5000));
 
+    // 播放器缓冲结束后在下一帧发送被延迟的请求
+    // 与组件的销毁都在主线程中，延迟的请求不会在取消的同时发起
+    NetworkAdmission::instance().setExecutor(
+        [](const NetworkAdmission::Task& task) { brls::sync(task); });
+    NetworkAdmission::instance().setTimer(
+        [](int ms, const NetworkAdmission::Task& task) {
+            brls::Threading::delay(ms, task);
+        });
+
+    // 创建窗口的同时预先解析域名并建立连接
+    bilibili::SessionPool::instance().warmUp(bilibili::Api::WarmUpHosts);
+
     // Set log level
     brls::Logger::setLogLevel(brls::LogLevel::LOG_ERROR);
     brls::Logger::debug("std::thread::hardware_concurrency(): {}",
@@ -92,6 +108,8 @@ int main(int argc, char* argv[]) {
     }
 
     brls::Logger::debug("main loop done");
+    // 保存图片缓存的索引
+    ImageDiskCache::instance().save();
     cpr::async::cleanup();
     curl_global_cleanup();
 
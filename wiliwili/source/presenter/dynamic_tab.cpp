@@ -17,7 +17,7 @@ void DynamicTabRequest::requestData() {
 
 void DynamicTabRequest::requestUpList() {
     CHECK_AND_SET_REQUEST
-    bilibili::BilibiliClient::dynamic_up_list(
+    this->requests.add(bilibili::BilibiliClient::dynamic_up_list(
         [this](const bilibili::DynamicUpListResultWrapper &result) {
             this->onUpList(result);
             UNSET_REQUEST
@@ -25,5 +25,5 @@ void DynamicTabRequest::requestUpList() {
         [this](const std::string &error) {
             this->onError(error);
             UNSET_REQUEST
-        });
+        }));
 }
\ No newline at end of file
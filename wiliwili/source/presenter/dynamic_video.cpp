@@ -32,7 +32,7 @@ void DynamicVideoRequest::requestData(bool refresh) {
 void DynamicVideoRequest::requestDynamicVideoList(unsigned int page,
                                                   const std::string &offset) {
     CHECK_AND_SET_REQUEST
-    bilibili::BilibiliClient::dynamic_video(
+    this->requests.add(bilibili::BilibiliClient::dynamic_video(
         page, offset,
         [this](const bilibili::DynamicVideoListResultWrapper &result) {
             if (currentPage != result.page) {
@@ -49,12 +49,12 @@ void DynamicVideoRequest::requestDynamicVideoList(unsigned int page,
         [this](const std::string &error) {
             this->onError(error);
             UNSET_REQUEST
-        });
+        }));
 }
 
 void DynamicVideoRequest::requestUserDynamicVideoList(int mid, int pn, int ps) {
     CHECK_AND_SET_REQUEST
-    bilibili::BilibiliClient::get_user_videos2(
+    this->requests.add(bilibili::BilibiliClient::get_user_videos2(
         mid, pn, ps,
         [this](const bilibili::UserDynamicVideoResultWrapper &result) {
             if (currentPage != result.page.pn) {
@@ -70,5 +70,5 @@ void DynamicVideoRequest::requestUserDynamicVideoList(int mid, int pn, int ps) {
         [this](const std::string &error) {
             this->onError(error);
             UNSET_REQUEST
-        });
+        }));
 }
\ No newline at end of file
@@ -18,7 +18,7 @@ void HomeHotsAllRequest::requestData(bool refresh) {
 
 void HomeHotsAllRequest::requestHotsAllVideoList(int index, int num) {
     CHECK_AND_SET_REQUEST
-    bilibili::BilibiliClient::get_hots_all(
+    this->requests.add(bilibili::BilibiliClient::get_hots_all(
         index, num,
         [this, index](const bilibili::HotsAllVideoListResult &result,
                       bool no_more) {
@@ -31,5 +31,5 @@ void HomeHotsAllRequest::requestHotsAllVideoList(int index, int num) {
         [this](const std::string &error) {
             this->onError(error);
             UNSET_REQUEST
-        });
+        }));
 }
@@ -17,7 +17,7 @@ void HomeHotsHistoryRequest::requestData() {
 
 void HomeHotsHistoryRequest::requestHotsHistoryVideoList() {
     CHECK_AND_SET_REQUEST
-    bilibili::BilibiliClient::get_hots_history(
+    this->requests.add(bilibili::BilibiliClient::get_hots_history(
         [this](const bilibili::HotsHistoryVideoListResult& result,
                const std::string& explain) {
             this->onHotsHistoryList(result, explain);
@@ -26,5 +26,5 @@ void HomeHotsHistoryRequest::requestHotsHistoryVideoList() {
         [this](const std::string& error) {
             this->onError(error);
             UNSET_REQUEST
-        });
+        }));
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "presenter/home_pgc.hpp"
 #include "bilibili.h"
+#include "utils/image_helper.hpp"
 
 void HomeBangumiRequest::onBangumiList(
     const bilibili::PGCResultWrapper& result) {}
@@ -25,7 +26,7 @@ void HomeBangumiRequest::requestData(bool refresh) {
 void HomeBangumiRequest::requestBangumiList(int is_refresh,
                                             std::string cursor) {
     CHECK_AND_SET_REQUEST
-    bilibili::BilibiliClient::get_bangumi(
+    this->requests.add(bilibili::BilibiliClient::get_bangumi(
         is_refresh, cursor,
         [this](const bilibili::PGCResultWrapper& result) {
             this->next_cursor = result.next_cursor;
@@ -35,7 +36,7 @@ void HomeBangumiRequest::requestBangumiList(int is_refresh,
         [this](const std::string& error) {
             this->onError(error);
             UNSET_REQUEST
-        });
+        }));
 }
 
 void HomeCinemaRequest::onCinemaList(const bilibili::PGCResultWrapper& result) {
@@ -57,7 +58,7 @@ void HomeCinemaRequest::requestData(bool refresh) {
 
 void HomeCinemaRequest::requestCinemaList(int is_refresh, std::string cursor) {
     CHECK_AND_SET_REQUEST
-    bilibili::BilibiliClient::get_cinema(
+    this->requests.add(bilibili::BilibiliClient::get_cinema(
         is_refresh, cursor,
         [this](const bilibili::PGCResultWrapper& result) {
             this->next_cursor = result.next_cursor;
@@ -67,7 +68,7 @@ void HomeCinemaRequest::requestCinemaList(int is_refresh, std::string cursor) {
         [this](const std::string& error) {
             this->onError(error);
             UNSET_REQUEST
-        });
+        }));
 }
 
 DataSourcePGCVideoList::DataSourcePGCVideoList(bilibili::PGCModuleResult result)
@@ -92,11 +93,14 @@ RecyclingGridItem* DataSourcePGCVideoList::cellForRow(RecyclingGrid* recycler,
 
     bilibili::PGCItemResult& r = this->videoList.items[index];
     if (item->isVertical()) {
-        item->setCard(r.cover + "@312w_420h_1c.jpg", r.title, r.desc,
-                      r.badge_info, r.bottom_left_badge, r.bottom_right_badge);
+        item->setCard(ImageHelper::thumbnail(r.cover, recycler->getItemWidth(),
+                                             ThumbnailType::VERTICAL),
+                      r.title, r.desc, r.badge_info, r.bottom_left_badge,
+                      r.bottom_right_badge);
     } else {
-        item->setCard(r.cover + "@672w_378h_1c.jpg", r.title, r.desc,
-                      r.badge_info, r.bottom_left_badge, r.bottom_right_badge);
+        item->setCard(ImageHelper::thumbnail(r.cover, recycler->getItemWidth()),
+                      r.title, r.desc, r.badge_info, r.bottom_left_badge,
+                      r.bottom_right_badge);
     }
     return item;
 }
@@ -21,7 +21,7 @@ void Home::requestData(bool refresh) {
 
 void Home::requestRecommendVideoList(int index, int num) {
     CHECK_AND_SET_REQUEST
-    bilibili::BilibiliClient::get_recommend(
+    this->requests.add(bilibili::BilibiliClient::get_recommend(
         index, num,
         [this](const bilibili::RecommendVideoListResultWrapper &result) {
             this->onRecommendVideoList(result);
@@ -30,5 +30,5 @@ void Home::requestRecommendVideoList(int index, int num) {
         [this](const std::string &error) {
             this->onError(error);
             UNSET_REQUEST
-        });
+        }));
 }
\ No newline at end of file
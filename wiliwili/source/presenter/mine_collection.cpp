@@ -30,7 +30,7 @@ void MineCollectionRequest::requestData(bool refresh) {
 void MineCollectionRequest::requestCollectionList(std::string &mid, int i,
                                                   int num) {
     CHECK_AND_SET_REQUEST
-    bilibili::BilibiliClient::get_my_collection_list(
+    this->requests.add(bilibili::BilibiliClient::get_my_collection_list(
         mid, i, num,
         [this](const bilibili::CollectionListResultWrapper &result) {
             if (index != result.index) {
@@ -48,5 +48,5 @@ void MineCollectionRequest::requestCollectionList(std::string &mid, int i,
         [this](const std::string &error) {
             this->onError(error);
             UNSET_REQUEST
-        });
+        }));
 }
\ No newline at end of file
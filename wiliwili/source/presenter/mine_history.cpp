@@ -18,7 +18,7 @@ void MineHistoryRequest::requestData(bool refresh) {
 
 void MineHistoryRequest::requestHistoryVideoList() {
     CHECK_AND_SET_REQUEST
-    bilibili::BilibiliClient::get_my_history(
+    this->requests.add(bilibili::BilibiliClient::get_my_history(
         cursor,
         [this](const bilibili::HistoryVideoResultWrapper &result) {
             this->onHistoryList(result);
@@ -28,5 +28,5 @@ void MineHistoryRequest::requestHistoryVideoList() {
         [this](const std::string &error) {
             this->onError(error);
             UNSET_REQUEST
-        });
+        }));
 }
\ No newline at end of file
@@ -29,7 +29,7 @@ void PGCIndexRequest::requestData(UserRequestData data, bool refresh) {
 
 void PGCIndexRequest::requestPGCIndex(const std::string& param, int page) {
     ASYNC_RETAIN
-    bilibili::BilibiliClient::get_pgc_index(
+    ASYNC_REQUEST(bilibili::BilibiliClient::get_pgc_index(
         param, page,
         [ASYNC_TOKEN](const bilibili::PGCIndexResultWrapper& result) {
             ASYNC_RELEASE
@@ -45,12 +45,12 @@ void PGCIndexRequest::requestPGCIndex(const std::string& param, int page) {
         [ASYNC_TOKEN](const std::string& error) {
             ASYNC_RELEASE
             this->onError(error);
-        });
+        }));
 }
 
 void PGCIndexRequest::requestPGCFilter() {
     ASYNC_RETAIN
-    bilibili::BilibiliClient::get_pgc_all_filter(
+    ASYNC_REQUEST(bilibili::BilibiliClient::get_pgc_all_filter(
         [ASYNC_TOKEN](const bilibili::PGCIndexFilters& result) {
             ASYNC_RELEASE
             INDEX_FILTERS = result;
@@ -59,5 +59,5 @@ void PGCIndexRequest::requestPGCFilter() {
         [ASYNC_TOKEN](const std::string& error) {
             ASYNC_RELEASE
             this->onError(error);
-        });
+        }));
 }
\ No newline at end of file
@@ -6,8 +6,44 @@
 #include "borealis.hpp"
 #include "presenter/video_detail.hpp"
 #include "utils/config_helper.hpp"
+#include "utils/network_admission.hpp"
 #include "view/mpv_core.hpp"
 
+/// 解析 XML 格式的弹幕，在子线程中调用
+static bool decodeDanmaku(const std::string& xml,
+                          std::vector<DanmakuItem>& items) {
+    brls::Logger::debug("DANMAKU: start decode");
+
+    // Load XML
+    tinyxml2::XMLDocument document = tinyxml2::XMLDocument();
+    tinyxml2::XMLError error       = document.Parse(xml.c_str());
+
+    if (error != tinyxml2::XMLError::XML_SUCCESS) {
+        brls::Logger::error("Error decode danmaku xml[1]: {}",
+                            std::to_string(error));
+        return false;
+    }
+    tinyxml2::XMLElement* element = document.RootElement();
+    if (!element) {
+        brls::Logger::error("Error decode danmaku xml[2]: no root element");
+        return false;
+    }
+
+    for (auto child = element->FirstChildElement(); child != nullptr;
+         child      = child->NextSiblingElement()) {
+        if (child->Name()[0] != 'd') continue;  // 简易判断是不是弹幕
+        try {
+            items.emplace_back(
+                DanmakuItem(child->GetText(), child->Attribute("p")));
+        } catch (...) {
+            brls::Logger::error("DANMAKU: error decode: {}", child->GetText());
+        }
+    }
+
+    brls::Logger::debug("DANMAKU: decode done: {}", items.size());
+    return true;
+}
+
 /// 请求视频数据
 void VideoDetail::requestData(const bilibili::VideoDetailResult& video) {
     this->requestVideoInfo(video.bvid);
@@ -27,7 +63,7 @@ void VideoDetail::requestSeasonInfo(const int seasonID, const int epID) {
     MPVCore::instance().reset();
 
     ASYNC_RETAIN
-    bilibili::BilibiliClient::get_season_detail(
+    ASYNC_REQUEST(bilibili::BilibiliClient::get_season_detail(
         seasonID, epID,
         [ASYNC_TOKEN, epID](const bilibili::SeasonResultWrapper& result) {
             brls::sync([ASYNC_TOKEN, result, epID]() {
@@ -67,7 +103,7 @@ void VideoDetail::requestSeasonInfo(const int seasonID, const int epID) {
         [ASYNC_TOKEN](const std::string& error) {
             ASYNC_RELEASE
             brls::Logger::error(error);
-        });
+        }));
 }
 
 /// 获取视频信息：标题、作者、简介、分P等
@@ -79,7 +115,7 @@ void VideoDetail::requestVideoInfo(const std::string bvid) {
 
     ASYNC_RETAIN
     brls::Logger::debug("请求视频信息: {}", bvid);
-    bilibili::BilibiliClient::get_video_detail_all(
+    ASYNC_REQUEST(bilibili::BilibiliClient::get_video_detail_all(
         bvid,
         [ASYNC_TOKEN](const bilibili::VideoDetailAllResult& result) {
             brls::sync([ASYNC_TOKEN, result]() {
@@ -143,7 +179,7 @@ void VideoDetail::requestVideoInfo(const std::string bvid) {
             ASYNC_RELEASE
             brls::Logger::error("ERROR:请求视频信息 {}", error);
             this->onError(error);
-        });
+        }));
 }
 
 /// 获取视频地址
@@ -155,7 +191,7 @@ void VideoDetail::requestVideoUrl(std::string bvid, int cid) {
                         defaultQuality);
     if (cid == 0) return ;
 
-    bilibili::BilibiliClient::get_video_url(
+    ASYNC_REQUEST(bilibili::BilibiliClient::get_video_url(
         bvid, cid, defaultQuality,
         [ASYNC_TOKEN](const bilibili::VideoUrlResult& result) {
             brls::sync([ASYNC_TOKEN, result]() {
@@ -167,7 +203,7 @@ void VideoDetail::requestVideoUrl(std::string bvid, int cid) {
         [ASYNC_TOKEN](const std::string& error) {
             ASYNC_RELEASE
             brls::Logger::error(error);
-        });
+        }));
 
     // 请求当前视频在线人数
     this->requestVideoOnline(bvid, cid);
@@ -182,7 +218,7 @@ void VideoDetail::requestSeasonVideoUrl(const std::string& bvid, int cid) {
 
     ASYNC_RETAIN
     brls::Logger::debug("请求番剧视频播放地址: {}", cid);
-    bilibili::BilibiliClient::get_season_url(
+    ASYNC_REQUEST(bilibili::BilibiliClient::get_season_url(
         cid, defaultQuality,
         [ASYNC_TOKEN](const bilibili::VideoUrlResult& result) {
             brls::sync([ASYNC_TOKEN, result]() {
@@ -195,7 +231,7 @@ void VideoDetail::requestSeasonVideoUrl(const std::string& bvid, int cid) {
         [ASYNC_TOKEN](const std::string& error) {
             ASYNC_RELEASE
             brls::Logger::error(error);
-        });
+        }));
 
     // 请求当前视频在线人数
     this->requestVideoOnline(bvid, cid);
@@ -238,7 +274,7 @@ void VideoDetail::requestVideoComment(int aid, int next, int mode) {
     }
     brls::Logger::debug("请求视频评论: {}", aid);
     ASYNC_RETAIN
-    bilibili::BilibiliClient::get_comment(
+    ASYNC_REQUEST(bilibili::BilibiliClient::get_comment(
         aid, commentRequestIndex, mode,
         [ASYNC_TOKEN](const bilibili::VideoCommentResultWrapper& result) {
             brls::sync([ASYNC_TOKEN, result]() {
@@ -253,7 +289,7 @@ void VideoDetail::requestVideoComment(int aid, int next, int mode) {
         [ASYNC_TOKEN](const std::string& error) {
             ASYNC_RELEASE
             this->onRequestCommentError(error);
-        });
+        }));
 }
 
 /// 获取Up主的其他视频
@@ -264,7 +300,7 @@ void VideoDetail::requestUploadedVideos(int mid, int pn, int ps) {
     brls::Logger::debug("请求投稿视频: {}/{}", mid,
                         userUploadedVideoRequestIndex);
     ASYNC_RETAIN
-    bilibili::BilibiliClient::get_user_videos(
+    ASYNC_REQUEST(bilibili::BilibiliClient::get_user_videos(
         mid, userUploadedVideoRequestIndex, ps,
         [ASYNC_TOKEN](const bilibili::UserUploadedVideoResultWrapper& result) {
             brls::sync([ASYNC_TOKEN, result]() {
@@ -280,92 +316,112 @@ void VideoDetail::requestUploadedVideos(int mid, int pn, int ps) {
         [ASYNC_TOKEN](const std::string& error) {
             ASYNC_RELEASE
             brls::Logger::error(error);
-        });
+        }));
 }
 
 /// 获取单个视频播放人数
 void VideoDetail::requestVideoOnline(const std::string& bvid, int cid) {
     brls::Logger::debug("请求当前视频在线人数: bvid: {} cid: {}", bvid, cid);
     ASYNC_RETAIN
-    bilibili::BilibiliClient::get_video_online(
-        bvid, cid,
-        [ASYNC_TOKEN](const bilibili::VideoOnlineTotal& result) {
-            brls::sync([ASYNC_TOKEN, result]() {
-                ASYNC_RELEASE
-                this->onVideoOnlineCount(result);
-            });
-        },
-        [ASYNC_TOKEN](const std::string& error) {
-            ASYNC_RELEASE
-            brls::Logger::error(error);
-        });
+    // 视频缓冲时延迟请求
+    ASYNC_REQUEST(NetworkAdmission::instance().deferRequest(
+        [ASYNC_TOKEN, bvid, cid]() {
+            return bilibili::BilibiliClient::get_video_online(
+                bvid, cid,
+                [ASYNC_TOKEN](const bilibili::VideoOnlineTotal& result) {
+                    brls::sync([ASYNC_TOKEN, result]() {
+                        ASYNC_RELEASE
+                        this->onVideoOnlineCount(result);
+                    });
+                },
+                [ASYNC_TOKEN](const std::string& error) {
+                    ASYNC_RELEASE
+                    brls::Logger::error(error);
+                });
+        }));
 }
 
 /// 获取视频的 点赞、投币、收藏情况
 void VideoDetail::requestVideoRelationInfo(const std::string& bvid) {
     ASYNC_RETAIN
-    bilibili::BilibiliClient::get_video_relation(
-        bvid,
-        [ASYNC_TOKEN](const bilibili::VideoRelation& result) {
-            brls::sync([ASYNC_TOKEN, result]() {
-                ASYNC_RELEASE
-                this->onVideoRelationInfo(result);
-            });
-        },
-        [ASYNC_TOKEN](const std::string& error) {
-            ASYNC_RELEASE
-            brls::Logger::error(error);
-        });
+    // 视频缓冲时延迟请求
+    ASYNC_REQUEST(NetworkAdmission::instance().deferRequest(
+        [ASYNC_TOKEN, bvid]() {
+            return bilibili::BilibiliClient::get_video_relation(
+                bvid,
+                [ASYNC_TOKEN](const bilibili::VideoRelation& result) {
+                    brls::sync([ASYNC_TOKEN, result]() {
+                        ASYNC_RELEASE
+                        this->onVideoRelationInfo(result);
+                    });
+                },
+                [ASYNC_TOKEN](const std::string& error) {
+                    ASYNC_RELEASE
+                    brls::Logger::error(error);
+                });
+        }));
 }
 
 /// 获取视频弹幕
 void VideoDetail::requestVideoDanmaku(const unsigned int cid) {
     brls::Logger::debug("请求弹幕：cid: {}", cid);
     ASYNC_RETAIN
-    bilibili::BilibiliClient::get_danmaku(
+    ASYNC_REQUEST(bilibili::BilibiliClient::get_danmaku(
         cid,
         [ASYNC_TOKEN](const std::string& result) {
             ASYNC_RELEASE
-            brls::Logger::debug("DANMAKU: start decode");
-
-            // Load XML
-            tinyxml2::XMLDocument document = tinyxml2::XMLDocument();
-            tinyxml2::XMLError error       = document.Parse(result.c_str());
-
-            if (error != tinyxml2::XMLError::XML_SUCCESS) {
-                brls::Logger::error("Error decode danmaku xml[1]: {}",
-                                    std::to_string(error));
-                return;
-            }
-            tinyxml2::XMLElement* element = document.RootElement();
-            if (!element) {
-                brls::Logger::error(
-                    "Error decode danmaku xml[2]: no root element");
-                return;
-            }
-
             std::vector<DanmakuItem> items;
-            for (auto child = element->FirstChildElement(); child != nullptr;
-                 child      = child->NextSiblingElement()) {
-                if (child->Name()[0] != 'd') continue;  // 简易判断是不是弹幕
-                try {
-                    items.emplace_back(
-                        DanmakuItem(child->GetText(), child->Attribute("p")));
-                } catch (...) {
-                    brls::Logger::error("DANMAKU: error decode: {}",
-                                        child->GetText());
-                }
-            }
-
+            if (!decodeDanmaku(result, items)) return;
             brls::sync(
                 [items]() { MPVCore::instance().loadDanmakuData(items); });
+        },
+        [ASYNC_TOKEN](const std::string& error) {
+            ASYNC_RELEASE
+            brls::Logger::error(error);
+        }));
+}
 
-            brls::Logger::debug("DANMAKU: decode done: {}", items.size());
+/// 预加载下一P或下一集
+void VideoDetail::requestNextVideo(const std::string& bvid, unsigned int cid,
+                                   bool season) {
+    brls::Logger::debug("预加载下一个视频: {}/{}", bvid, cid);
+    {
+        ASYNC_RETAIN
+        auto onUrl = [ASYNC_TOKEN,
+                      cid](const bilibili::VideoUrlResult& result) {
+            brls::sync([ASYNC_TOKEN, cid, result]() {
+                ASYNC_RELEASE
+                this->onNextVideoPlayUrl(cid, result);
+            });
+        };
+        auto onError = [ASYNC_TOKEN](const std::string& error) {
+            ASYNC_RELEASE
+            brls::Logger::error("预加载下一个视频失败: {}", error);
+        };
+        if (season) {
+            ASYNC_REQUEST(bilibili::BilibiliClient::get_season_url(
+                cid, defaultQuality, onUrl, onError));
+        } else {
+            ASYNC_REQUEST(bilibili::BilibiliClient::get_video_url(
+                bvid, cid, defaultQuality, onUrl, onError));
+        }
+    }
+
+    ASYNC_RETAIN
+    ASYNC_REQUEST(bilibili::BilibiliClient::get_danmaku(
+        cid,
+        [ASYNC_TOKEN, cid](const std::string& result) {
+            std::vector<DanmakuItem> items;
+            decodeDanmaku(result, items);
+            brls::sync([ASYNC_TOKEN, cid, items]() {
+                ASYNC_RELEASE
+                this->onNextVideoDanmaku(cid, items);
+            });
         },
         [ASYNC_TOKEN](const std::string& error) {
             ASYNC_RELEASE
             brls::Logger::error(error);
-        });
+        }));
 }
 
 /// 上报历史记录
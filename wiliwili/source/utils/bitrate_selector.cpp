@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "utils/bitrate_selector.hpp"
+
+/// 累计采样时间少于此值 (秒) 时不估计带宽
+static const double MIN_SAMPLE_TIME = 2;
+
+/// 两次采样间隔较长时最多计入的时间 (秒)，避免一次采样影响过大
+static const double MAX_SAMPLE_TIME = 2;
+
+void BitrateSelector::Average::add(double duration, double sample) {
+    double alpha = std::pow(0.5, duration / halfLife);
+    value        = sample * (1 - alpha) + value * alpha;
+    weight += duration;
+}
+
+double BitrateSelector::Average::get() const {
+    if (weight <= 0) return 0;
+    // 初始值为 0，采样较少时需要修正
+    return value / (1 - std::pow(0.5, weight / halfLife));
+}
+
+size_t BitrateSelector::getStartIndex(const std::vector<unsigned int>& list,
+                                      size_t index) const {
+    if (!ENABLED || list.empty() || getEstimate() <= 0) return index;
+    return std::min(index, getTarget(list));
+}
+
+void BitrateSelector::setBitrates(const std::vector<unsigned int>& list,
+                                  size_t current, double time) {
+    bitrates   = list;
+    index      = list.empty() ? 0 : std::min(current, list.size() - 1);
+    lastSwitch = time;
+}
+
+size_t BitrateSelector::update(double time, int64_t speed, double buffer,
+                               bool limited) {
+    // 缓存接近上限时 mpv 只按照播放的速度补充缓存，下载速度接近当前的码率
+    double cacheTime = getCacheTime();
+    if (buffer >= cacheTime * CACHE_FULL) limited = true;
+    if (lastSample >= 0 && speed > 0 && !limited && time > lastSample) {
+        double duration = std::min(time - lastSample, MAX_SAMPLE_TIME);
+        fast.add(duration, speed * 8.0);
+        slow.add(duration, speed * 8.0);
+    }
+    lastSample = time;
+    if (!ENABLED || bitrates.size() <= 1 || getEstimate() <= 0) return index;
+
+    // 缓存较小时缓冲无法达到 HIGH_BUFFER，两个阈值按比例降低
+    double high   = std::min(HIGH_BUFFER, cacheTime * HIGH_BUFFER_RATIO);
+    double low    = LOW_BUFFER * high / HIGH_BUFFER;
+    size_t target = getTarget(bitrates);
+    if (target < index && buffer < low) {
+        // 带宽不足且缓冲即将耗尽，直接降到带宽能够支持的码率
+        return this->switchTo(target, time);
+    }
+    if (target > index && buffer >= high &&
+        time - lastSwitch >= SWITCH_INTERVAL) {
+        // 每次只提高一级，避免带宽估计偏高时来回切换
+        return this->switchTo(index + 1, time);
+    }
+    return index;
+}
+
+size_t BitrateSelector::reportStall(double time) {
+    if (!ENABLED || index == 0) return index;
+    size_t target = index - 1;
+    if (getEstimate() > 0) target = std::min(target, getTarget(bitrates));
+    return this->switchTo(target, time);
+}
+
+double BitrateSelector::getEstimate() const {
+    if (slow.weight < MIN_SAMPLE_TIME) return 0;
+    // 网速下降时快速反应，上升时缓慢跟随
+    return std::min(fast.get(), slow.get());
+}
+
+size_t BitrateSelector::getTarget(const std::vector<unsigned int>& list) const {
+    double budget = getEstimate() * SAFETY_FACTOR;
+    size_t target = 0;
+    for (size_t i = 1; i < list.size(); i++)
+        if (list[i] <= budget) target = i;
+    return target;
+}
+
+double BitrateSelector::getCacheTime() const {
+    if (cacheSize < 0 || bitrates.empty() || bitrates[index] == 0)
+        return std::numeric_limits<double>::infinity();
+    if (cacheSize == 0) return READAHEAD_TIME;
+    return cacheSize * 8.0 / bitrates[index];
+}
+
+size_t BitrateSelector::switchTo(size_t target, double time) {
+    if (target == index) return index;
+    index      = target;
+    lastSwitch = time;
+    return index;
+}
@@ -0,0 +1,89 @@
+#include <borealis.hpp>
+
+#include "utils/cache_helper.hpp"
+
+int TextureCache::getCache(const std::string& url) {
+    auto it = urls.find(url);
+    if (it == urls.end()) return 0;
+    auto& item = it->second;
+    if (item->refs++ == 0) liveBytes += item->bytes;
+    textures.splice(textures.begin(), textures, item);
+    return item->texture;
+}
+
+int TextureCache::addCache(const std::string& url, int texture) {
+    if (texture <= 0) return texture;
+
+    // 同一张图片同时加载了多次
+    int tex = this->getCache(url);
+    if (tex > 0) {
+        if (tex != texture)
+            nvgDeleteImage(brls::Application::getNVGContext(), texture);
+        return tex;
+    }
+
+    int width = 0, height = 0;
+    nvgImageSize(brls::Application::getNVGContext(), texture, &width, &height);
+
+    Texture item;
+    item.url     = url;
+    item.texture = texture;
+    item.bytes   = (size_t)width * height * 4;
+    item.refs    = 1;
+    textures.push_front(item);
+    urls[url]    = textures.begin();
+    ids[texture] = textures.begin();
+    bytes += item.bytes;
+    liveBytes += item.bytes;
+
+    this->trim();
+    return texture;
+}
+
+void TextureCache::release(int texture) {
+    auto it = ids.find(texture);
+    if (it == ids.end()) return;
+    auto& item = it->second;
+    if (item->refs <= 0) return;
+    if (--item->refs == 0) liveBytes -= item->bytes;
+    this->trim();
+}
+
+void TextureCache::setCapacity(size_t size) {
+    this->capacity = size * 1024 * 1024;
+    this->trim();
+}
+
+void TextureCache::trim() {
+    if (bytes <= capacity || textures.empty()) return;
+    auto vg       = brls::Application::getNVGContext();
+    auto it       = std::prev(textures.end());
+    size_t before = bytes;
+    while (bytes > capacity) {
+        bool first = it == textures.begin();
+        auto prev  = first ? it : std::prev(it);
+        // 正在显示的纹理不能删除
+        if (it->refs <= 0) {
+            nvgDeleteImage(vg, it->texture);
+            bytes -= it->bytes;
+            urls.erase(it->url);
+            ids.erase(it->texture);
+            textures.erase(it);
+        }
+        if (first) break;
+        it = prev;
+    }
+    if (bytes == before) return;
+    brls::Logger::debug("texture cache: {}KB, {}KB in use", bytes / 1024,
+                        liveBytes / 1024);
+}
+
+void TextureCache::clean() {
+    auto vg = brls::Application::getNVGContext();
+    for (auto& i : textures) nvgDeleteImage(vg, i.texture);
+    textures.clear();
+    urls.clear();
+    ids.clear();
+    bytes     = 0;
+    liveBytes = 0;
+}
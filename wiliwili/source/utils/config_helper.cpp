@@ -5,8 +5,12 @@
 #include <borealis.hpp>
 
 #include "bilibili.h"
+#include "bilibili/util/response_cache.hpp"
+#include "utils/bitrate_selector.hpp"
 #include "utils/config_helper.hpp"
 #include "utils/cache_helper.hpp"
+#include "utils/image_disk_cache.hpp"
+#include "utils/mirror_selector.hpp"
 #include "utils/number_helper.hpp"
 #include "presenter/video_detail.hpp"
 #include "view/mpv_core.hpp"
@@ -17,8 +21,11 @@ std::unordered_map<SettingItem, std::string> ProgramConfig::SETTING_MAP = {
     {SettingItem::HISTORY_REPORT, "history_report"},
     {SettingItem::PLAYER_BOTTOM_BAR, "player_bottom_bar"},
     {SettingItem::PLAYER_LOW_QUALITY, "player_low_quality"},
+    {SettingItem::PLAYER_DIRECT_RENDER, "player_direct_render"},
+    {SettingItem::PLAYER_DEBUG_INFO, "player_debug_info"},
+    {SettingItem::PLAYER_ABR, "player_abr"},
     {SettingItem::PLAYER_INMEMORY_CACHE, "player_inmemory_cache"},
-    {SettingItem::TEXTURE_CACHE_NUM, "texture_cache_num"},
+    {SettingItem::TEXTURE_CACHE_SIZE, "texture_cache_size"},
     {SettingItem::OPENCC_ON, "opencc"},
     {SettingItem::CUSTOM_UPDATE_API, "custom_update_api"},
 };
@@ -108,9 +115,9 @@ void ProgramConfig::load() {
     // 初始化是否固定显示底部进度条
     MPVCore::BOTTOM_BAR = getSettingItem(SettingItem::PLAYER_BOTTOM_BAR, true);
 
-    // 初始化纹理缓存数量
-    TextureCache::instance().cache.setCapacity(
-        getSettingItem(SettingItem::TEXTURE_CACHE_NUM, 200));
+    // 初始化纹理缓存大小 (MB)
+    TextureCache::instance().setCapacity(
+        getSettingItem(SettingItem::TEXTURE_CACHE_SIZE, 64));
 
     // 初始化内存缓存大小
     MPVCore::INMEMORY_CACHE =
@@ -127,6 +134,17 @@ void ProgramConfig::load() {
     MPVCore::LOW_QUALITY =
         getSettingItem(SettingItem::PLAYER_LOW_QUALITY, false);
 #endif
+
+    // 全屏播放时是否直接渲染到窗口
+    MPVCore::DIRECT_RENDER =
+        getSettingItem(SettingItem::PLAYER_DIRECT_RENDER, true);
+
+    // 是否在播放器上显示渲染统计
+    MPVCore::DEBUG_INFO =
+        getSettingItem(SettingItem::PLAYER_DEBUG_INFO, false);
+
+    // 是否根据网速自动切换码率
+    BitrateSelector::ENABLED = getSettingItem(SettingItem::PLAYER_ABR, true);
 }
 
 void ProgramConfig::save() {
@@ -145,6 +163,14 @@ void ProgramConfig::save() {
 
 void ProgramConfig::init() {
     this->load();
+    // 接口缓存
+    bilibili::ResponseCache::CACHE_DIR = this->getConfigDir() + "/cache/api";
+    // 图片缓存
+    ImageDiskCache::CACHE_DIR = this->getConfigDir() + "/cache/image";
+    ImageDiskCache::instance().load();
+    // CDN 节点测速记录
+    MirrorSelector::HISTORY_PATH = this->getConfigDir() + "/mirrors.json";
+    MirrorSelector::instance().load();
     Cookie diskCookie = this->getCookie();
     // set bilibili cookie and cookie update callback
     bilibili::BilibiliClient::init(
@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <stb_image.h>
+#ifdef USE_WEBP
+#include <webp/decode.h>
+#endif
+
+#include "utils/image_decoder.hpp"
+
+/// 按整数倍缩小图片，每个像素取原图对应区域的平均值
+static void downscale(ImageData& image, int factor) {
+    int width  = image.width / factor;
+    int height = image.height / factor;
+    int area   = factor * factor;
+    std::vector<unsigned char> pixels(width * height * 4);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int sum[4] = {0, 0, 0, 0};
+            for (int fy = 0; fy < factor; fy++) {
+                const unsigned char* row =
+                    &image.pixels[((y * factor + fy) * image.width +
+                                   x * factor) * 4];
+                for (int fx = 0; fx < factor * 4; fx++) sum[fx % 4] += row[fx];
+            }
+            unsigned char* dst = &pixels[(y * width + x) * 4];
+            for (int c = 0; c < 4; c++) dst[c] = sum[c] / area;
+        }
+    }
+    image.width  = width;
+    image.height = height;
+    image.pixels = std::move(pixels);
+}
+
+std::shared_ptr<ImageData> decodeImage(const std::string& data, float width,
+                                       float height) {
+    auto image = std::make_shared<ImageData>();
+#ifdef USE_WEBP
+    uint8_t* webp = WebPDecodeRGBA((const uint8_t*)data.c_str(), data.size(),
+                                   &image->width, &image->height);
+    if (webp) {
+        image->pixels.assign(webp, webp + image->width * image->height * 4);
+        WebPFree(webp);
+    }
+#endif
+    if (image->pixels.empty()) {
+        int n;
+        unsigned char* pixels = stbi_load_from_memory(
+            (const unsigned char*)data.c_str(), data.size(), &image->width,
+            &image->height, &n, 4);
+        if (!pixels) return nullptr;
+        image->pixels.assign(pixels,
+                             pixels + image->width * image->height * 4);
+        stbi_image_free(pixels);
+    }
+
+    // 高度未知时只按照宽度缩小
+    if (width > 0) {
+        float factor = image->width / width;
+        if (height > 0) factor = std::min(factor, image->height / height);
+        if (factor >= 2) downscale(*image, (int)factor);
+    }
+    return image;
+}
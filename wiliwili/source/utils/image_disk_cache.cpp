@@ -0,0 +1,202 @@
+#include <borealis.hpp>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <thread>
+#include <vector>
+
+#include "bilibili/util/md5.hpp"
+#include "utils/image_disk_cache.hpp"
+
+/// 索引修改超过此次数后保存一次，避免程序异常退出时丢失太多记录
+static const size_t SAVE_INTERVAL = 32;
+
+std::string ImageDiskCache::getKey(const std::string& url) {
+    return websocketpp::md5::md5_hash_hex(url);
+}
+
+std::string ImageDiskCache::getPath(const std::string& key) {
+    return CACHE_DIR + "/" + key;
+}
+
+bool ImageDiskCache::get(const std::string& url, std::string& data) {
+    if (CACHE_DIR.empty()) return false;
+    std::string key = getKey(url);
+    {
+        std::unique_lock<std::mutex> lock(cacheMutex);
+        auto it = keys.find(key);
+        if (it == keys.end()) return false;
+        entries.splice(entries.begin(), entries, it->second);
+        dirty++;
+    }
+
+    // 读取文件时不持有锁，多个线程可以同时读取
+    std::ifstream readFile(getPath(key), std::ios::binary | std::ios::ate);
+    if (readFile) {
+        data.resize(readFile.tellg());
+        readFile.seekg(0);
+        readFile.read(&data[0], data.size());
+        if (readFile && !data.empty()) return true;
+    }
+
+    // 文件已经被删除或损坏
+    std::unique_lock<std::mutex> lock(cacheMutex);
+    auto it = keys.find(key);
+    if (it != keys.end()) {
+        bytes -= it->second->size;
+        entries.erase(it->second);
+        keys.erase(it);
+    }
+    return false;
+}
+
+void ImageDiskCache::put(const std::string& url, const std::string& data) {
+    if (CACHE_DIR.empty() || data.empty()) return;
+    std::string key  = getKey(url);
+    std::string path = getPath(key);
+
+    // 先写入临时文件再重命名，其他线程不会读到不完整的图片
+    std::error_code ec;
+    size_t thread    = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    std::string temp = path + "." + std::to_string(thread) + ".tmp";
+    std::ofstream writeFile(temp, std::ios::binary);
+    if (!writeFile) {
+        brls::Logger::error("ImageDiskCache: cannot write to {}", temp);
+        return;
+    }
+    writeFile.write(data.c_str(), data.size());
+    writeFile.close();
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(cacheMutex);
+    auto it = keys.find(key);
+    if (it == keys.end()) {
+        entries.push_front({key, data.size()});
+        keys[key] = entries.begin();
+    } else {
+        bytes -= it->second->size;
+        it->second->size = data.size();
+        entries.splice(entries.begin(), entries, it->second);
+    }
+    bytes += data.size();
+    dirty++;
+    this->trim();
+    if (dirty >= SAVE_INTERVAL) this->saveIndex();
+}
+
+void ImageDiskCache::trim() {
+    std::error_code ec;
+    while (bytes > CAPACITY && entries.size() > 1) {
+        auto& entry = entries.back();
+        std::filesystem::remove(getPath(entry.key), ec);
+        bytes -= entry.size;
+        keys.erase(entry.key);
+        entries.pop_back();
+        dirty++;
+    }
+}
+
+void ImageDiskCache::load() {
+    if (CACHE_DIR.empty()) return;
+    std::unique_lock<std::mutex> lock(cacheMutex);
+    entries.clear();
+    keys.clear();
+    bytes = 0;
+    dirty = 0;
+
+    std::error_code ec;
+    std::filesystem::create_directories(CACHE_DIR, ec);
+
+    // 索引中记录的使用顺序
+    std::vector<std::string> order;
+    std::ifstream readFile(CACHE_DIR + "/index.json");
+    if (readFile) {
+        try {
+            nlohmann::json content = nlohmann::json::parse(readFile);
+            for (auto& i : content) order.push_back(i.at(0).get<std::string>());
+        } catch (const std::exception& e) {
+            brls::Logger::error("ImageDiskCache: cannot load index: {}",
+                                e.what());
+            order.clear();
+        }
+    }
+
+    // 以目录中的文件为准，程序异常退出时索引可能缺少最后写入的图片
+    // 同时清理未写入完成的临时文件
+    std::unordered_map<std::string, size_t> files;
+    for (auto& i : std::filesystem::directory_iterator(CACHE_DIR, ec)) {
+        if (!i.is_regular_file(ec)) continue;
+        std::string name = i.path().filename().string();
+        if (name == "index.json") continue;
+        if (i.path().extension() == ".tmp") {
+            std::filesystem::remove(i.path(), ec);
+            continue;
+        }
+        files[name] = (size_t)i.file_size(ec);
+    }
+
+    // 按照索引中的顺序加入，跳过已经不存在的文件
+    for (auto& key : order) {
+        auto it = files.find(key);
+        if (it == files.end() || keys.count(key)) continue;
+        entries.push_back({key, it->second});
+        keys[key] = std::prev(entries.end());
+        bytes += it->second;
+    }
+    size_t indexed = entries.size();
+
+    // 不在索引中的图片是上次保存索引之后写入的，视为最近使用
+    for (auto& i : files) {
+        if (keys.count(i.first)) continue;
+        entries.push_front({i.first, i.second});
+        keys[i.first] = entries.begin();
+        bytes += i.second;
+    }
+    if (indexed != order.size() || entries.size() != indexed) {
+        brls::Logger::info("ImageDiskCache: {} images, {} not in index",
+                           entries.size(), entries.size() - indexed);
+        dirty++;
+    }
+    this->trim();
+    if (dirty > 0) this->saveIndex();
+}
+
+void ImageDiskCache::save() {
+    std::unique_lock<std::mutex> lock(cacheMutex);
+    if (dirty > 0) this->saveIndex();
+}
+
+void ImageDiskCache::saveIndex() {
+    if (CACHE_DIR.empty()) return;
+    nlohmann::json content = nlohmann::json::array();
+    for (auto& i : entries) content.push_back({i.key, i.size});
+
+    std::error_code ec;
+    std::string path = CACHE_DIR + "/index.json";
+    std::string temp = path + ".tmp";
+    std::ofstream writeFile(temp);
+    if (!writeFile) {
+        brls::Logger::error("ImageDiskCache: cannot write to {}", temp);
+        return;
+    }
+    writeFile << content.dump();
+    writeFile.close();
+    std::filesystem::rename(temp, path, ec);
+    dirty = 0;
+}
+
+void ImageDiskCache::clear() {
+    if (CACHE_DIR.empty()) return;
+    std::unique_lock<std::mutex> lock(cacheMutex);
+    entries.clear();
+    keys.clear();
+    bytes = 0;
+    dirty = 0;
+    std::error_code ec;
+    std::filesystem::remove_all(CACHE_DIR, ec);
+    std::filesystem::create_directories(CACHE_DIR, ec);
+}
@@ -3,14 +3,95 @@
 //
 
 #include "utils/image_helper.hpp"
+#include "utils/image_decoder.hpp"
 #include "utils/singleton.hpp"
 #include "utils/cache_helper.hpp"
+#include "utils/image_disk_cache.hpp"
 #include "utils/thread_helper.hpp"
+#include "utils/network_admission.hpp"
+#include "utils/texture_atlas.hpp"
+#include "view/atlas_image.hpp"
+#include "bilibili/util/session_pool.hpp"
 #include "borealis/core/thread.hpp"
 
-std::vector<std::shared_ptr<ImageHelper>> ImageHelper::imagePool;
+std::unordered_map<brls::Image*, std::shared_ptr<ImageHelper>>
+    ImageHelper::requests;
+std::vector<std::shared_ptr<ImageHelper>> ImageHelper::freeList;
+ImageQueue<std::shared_ptr<ImageHelper>> ImageHelper::pending;
+std::unordered_set<std::string> ImageHelper::prefetching;
+std::vector<std::shared_ptr<ImageHelper>> ImageHelper::uploads;
+bool ImageHelper::uploadScheduled = false;
+ImageHelper::UploadStats ImageHelper::uploadStats;
 std::default_random_engine ImageHelper::random_engine;
 
+static auto startTime = std::chrono::steady_clock::now();
+
+/// 记录启动后显示第一张图片的耗时
+static void logFirstCover() {
+    static std::atomic<bool> logged{false};
+    if (logged.exchange(true)) return;
+    auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    brls::Logger::info("time to first cover: {}ms", cost.count());
+}
+
+/// 预加载的图片解码后暂存在内存中，显示时只需要上传纹理
+class BitmapCache : public Singleton<BitmapCache> {
+public:
+    /// 取出图片，取出后从缓存中删除
+    std::shared_ptr<ImageData> take(const std::string& url) {
+        std::unique_lock<std::mutex> lock(bitmapMutex);
+        auto it = urls.find(url);
+        if (it == urls.end()) return nullptr;
+        auto data = it->second->second;
+        bytes -= data->pixels.size();
+        bitmaps.erase(it->second);
+        urls.erase(it);
+        return data;
+    }
+
+    bool contains(const std::string& url) {
+        std::unique_lock<std::mutex> lock(bitmapMutex);
+        return urls.count(url) > 0;
+    }
+
+    /// 超过容量时删除最早加入的图片
+    void put(const std::string& url, const std::shared_ptr<ImageData>& data) {
+        std::unique_lock<std::mutex> lock(bitmapMutex);
+        if (urls.count(url)) return;
+        bitmaps.emplace_front(url, data);
+        urls[url] = bitmaps.begin();
+        bytes += data->pixels.size();
+        while (bytes > ImageHelper::BITMAP_CACHE_SIZE && bitmaps.size() > 1) {
+            bytes -= bitmaps.back().second->pixels.size();
+            urls.erase(bitmaps.back().first);
+            bitmaps.pop_back();
+        }
+    }
+
+private:
+    using Bitmap = std::pair<std::string, std::shared_ptr<ImageData>>;
+    std::list<Bitmap> bitmaps;
+    std::unordered_map<std::string, std::list<Bitmap>::iterator> urls;
+    size_t bytes = 0;
+    std::mutex bitmapMutex;
+};
+
+/// 创建纹理并加入纹理缓存，返回应当使用的纹理，只能在主线程中调用
+static int uploadImage(const std::string& url, const ImageData& data) {
+    auto start     = std::chrono::steady_clock::now();
+    NVGcontext* vg = brls::Application::getNVGContext();
+    int tex        = nvgCreateImageRGBA(vg, data.width, data.height, 0,
+                                        data.pixels.data());
+    if (tex > 0) tex = TextureCache::instance().addCache(url, tex);
+    brls::Logger::debug(
+        "upload pic {}x{}: {}us", data.width, data.height,
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    return tex;
+}
+
 class ImageThreadPool : public cpr::ThreadPool,
                         public Singleton<ImageThreadPool> {
 public:
@@ -36,14 +117,14 @@ void ImageHelper::init() {
 void ImageHelper::clean() {}
 
 std::shared_ptr<ImageHelper> ImageHelper::with(brls::View* view) {
-    for (auto i : imagePool) {
-        if (i->isAvailable()) {
-            i->setCurrentView(view);
-            return i;
-        }
+    std::shared_ptr<ImageHelper> item;
+    if (freeList.empty()) {
+        item = std::make_shared<ImageHelper>(view);
+    } else {
+        item = freeList.back();
+        freeList.pop_back();
+        item->setCurrentView(view);
     }
-    auto item = std::make_shared<ImageHelper>(view);
-    imagePool.push_back(item);
     return item;
 }
 
@@ -57,29 +138,15 @@ void ImageHelper::setCurrentView(brls::View* view) {
 }
 
 void ImageHelper::cancel() {
-    std::unique_lock<std::mutex> lock(this->availableMutex);
-    // 已经加载结束、出错或被取消
-    if (this->available) {
-        if (this->imageView) this->imageView->clear();
-        brls::Logger::verbose("Cancel loading pictures (done): {}",
-                              (size_t)this->imageView);
+    // 已经加载结束、出错或被取消时不做处理
+    State loading = State::LOADING;
+    if (!this->state.compare_exchange_strong(loading, State::CANCELLED))
         return;
-    }
-    this->isCancel = true;
     brls::Logger::verbose("Cancel loading pictures: {}",
                           (size_t)this->imageView);
 }
 
-bool ImageHelper::isAvailable() { return this->available; }
-
-void ImageHelper::setAvailable(bool value) {
-    this->available = value;
-    if (value) {
-        this->imageView = nullptr;
-    } else {
-        this->isCancel = false;
-    }
-}
+bool ImageHelper::isAvailable() { return this->state == State::IDLE; }
 
 ImageHelper* ImageHelper::load(std::string url) {
     this->imageUrl = url;
@@ -87,81 +154,323 @@ ImageHelper* ImageHelper::load(std::string url) {
 }
 
 ImageHelper* ImageHelper::into(brls::Image* image) {
-    std::unique_lock<std::mutex> lock(this->availableMutex);
-    if (!this->available) {
+    if (!this->isAvailable()) {
         brls::Logger::error("Image: {} is not available now", (size_t)image);
         return this;
     }
 
-    this->imageView = image;
-    image->setFreeTexture(false);
-    this->setAvailable(false);
+    // 取消这张图片上一次未完成的请求
+    auto it = requests.find(image);
+    if (it != requests.end()) {
+        it->second->cancel();
+        requests.erase(it);
+    }
 
-    // 禁止删除图片
-    image->ptrLock();
+    // 释放图片之前使用的纹理，不在纹理缓存中的纹理 (如 XML 中设置的默认图片)
+    // 由图片自己删除
+    auto* atlasImage = dynamic_cast<AtlasImage*>(image);
+    if (atlasImage) {
+        atlasImage->releaseImage();
+    } else if (image->getTexture() > 0) {
+        TextureCache::instance().release(image->getTexture());
+        image->clear();
+    }
+    image->setFreeTexture(false);
 
-    // 先检查缓存
+    // 先检查缓存，较小的图片可能在图集中
+    if (atlasImage && TextureAtlas::instance().getCache(this->imageUrl)) {
+        brls::Logger::verbose("atlas hit: {}", this->imageUrl);
+        atlasImage->setAtlasImage(this->imageUrl);
+        this->recycle();
+        return this;
+    }
     int tex = TextureCache::instance().getCache(this->imageUrl);
     if (tex > 0) {
         brls::Logger::verbose("cache hit: {}", this->imageUrl);
         image->innerSetImage(tex);
-        this->setAvailable(true);
-        image->ptrUnlock();
+        this->recycle();
         return this;
     }
 
-    ImageThreadPool::instance().Submit([this, image]() {
-        cpr::Response r = cpr::Get(
-#ifndef VERIFY_SSL
-            cpr::VerifySsl{false},
-#endif
-            cpr::Url{this->imageUrl},
-            cpr::ProgressCallback(
-                [this](cpr::cpr_off_t downloadTotal, cpr::cpr_off_t downloadNow,
-                       cpr::cpr_off_t uploadTotal, cpr::cpr_off_t uploadNow,
-                       intptr_t userdata) -> bool {
-                    if (this->isCancel) {
-                        return false;
-                    }
-                    return true;
-                }));
-        brls::Logger::verbose("net image status code: {} / {}", r.status_code,
-                              r.downloaded_bytes);
-        std::unique_lock<std::mutex> lock(this->availableMutex);
-        if (r.status_code != 200 || r.downloaded_bytes == 0 || this->isCancel) {
-            brls::Logger::verbose("undone pic:{}", r.url.str());
-            this->setAvailable(true);
-            image->ptrUnlock();
-        } else {
-            brls::Logger::verbose("load pic:{} size:{}bytes by{} to {} {}",
-                                  r.url.str(), r.downloaded_bytes, (size_t)this,
-                                  (size_t)image, image->describe());
-            brls::sync([this, image, r]() {
-                std::unique_lock<std::mutex> lock(this->availableMutex);
-                if (this->isCancel) return;
-                image->setImageFromMem((unsigned char*)r.text.c_str(),
-                                       (size_t)r.downloaded_bytes);
-                if (image->getTexture() > 0)
-                    TextureCache::instance().addCache(this->imageUrl,
-                                                      image->getTexture());
-                this->setAvailable(true);
-                image->ptrUnlock();
-            });
+    this->state     = State::LOADING;
+    this->imageView = image;
+    requests[image] = shared_from_this();
+
+    // 禁止删除图片
+    image->ptrLock();
+
+    // 显示尺寸 (像素)，用于在解码时缩小图片
+    this->targetWidth  = image->getWidth() * brls::Application::windowScale;
+    this->targetHeight = image->getHeight() * brls::Application::windowScale;
+    // 新添加的图片通常即将显示，等待下一次更新距离
+    this->priority = 0;
+
+    // 预加载过的图片只需要上传纹理
+    auto data = BitmapCache::instance().take(this->imageUrl);
+    if (data) {
+        brls::Logger::verbose("prefetch hit: {}", this->imageUrl);
+        this->queueUpload(data);
+        return this;
+    }
+
+    pending.push(shared_from_this());
+    ImageThreadPool::instance().Submit([]() { ImageHelper::runNext(); });
+    return this;
+}
+
+void ImageHelper::prefetch(const std::string& url, float width,
+                           float distance) {
+    if (url.empty() || prefetching.size() >= PREFETCH_LIMIT) return;
+    if (prefetching.count(url) || TextureCache::instance().hasCache(url) ||
+        TextureAtlas::instance().hasCache(url) ||
+        BitmapCache::instance().contains(url))
+        return;
+    prefetching.insert(url);
+
+    auto item          = ImageHelper::with(nullptr);
+    item->imageUrl     = url;
+    item->targetWidth  = width * brls::Application::windowScale;
+    item->targetHeight = 0;
+    item->priority     = distance;
+    item->state        = State::LOADING;
+    pending.push(item);
+    ImageThreadPool::instance().Submit([]() { ImageHelper::runNext(); });
+}
+
+void ImageHelper::updatePriority(
+    const std::function<float(brls::View*)>& distance) {
+    for (auto& i : requests) {
+        float value = distance(i.second->currentView);
+        if (value >= 0) i.second->priority = value;
+    }
+}
+
+void ImageHelper::runNext() {
+    while (true) {
+        std::shared_ptr<ImageHelper> item;
+        if (!pending.pop(item)) return;
+
+        // 还没有开始下载就被取消的请求直接丢弃
+        if (item->state != State::LOADING) {
+            brls::sync([item]() { item->finish(); });
+            continue;
         }
+        item->run();
+        return;
+    }
+}
+
+void ImageHelper::run() {
+    // 优先读取磁盘缓存，读取缓存不占用网络
+    std::string body;
+    if (ImageDiskCache::instance().get(this->imageUrl, body)) {
+        this->decode(body, true);
+        return;
+    }
+
+    // 播放器缓冲时排队等待，不占用线程池中的线程
+    auto self = shared_from_this();
+    NetworkAdmission::instance().submit([self]() {
+        ImageThreadPool::instance().Submit([self]() {
+            std::string body;
+            // 排队时被取消的请求不再下载
+            if (self->state == State::LOADING) body = self->download();
+            NetworkAdmission::instance().release();
+            self->decode(body, false);
+        });
     });
-    return this;
+}
+
+void ImageHelper::decode(const std::string& body, bool cached) {
+    // 在子线程中解码，主线程只需要上传纹理
+    std::shared_ptr<ImageData> data;
+    if (!body.empty() && this->state == State::LOADING)
+        data = decodeImage(body, this->targetWidth, this->targetHeight);
+    if (data && !cached) ImageDiskCache::instance().put(this->imageUrl, body);
+
+    brls::Image* image = this->imageView;
+    // 预加载的图片只解码，显示时再上传纹理
+    if (!image && data) BitmapCache::instance().put(this->imageUrl, data);
+    if (data)
+        brls::Logger::verbose("load pic:{} size:{}bytes by{} to {}",
+                              this->imageUrl, body.size(), (size_t)this,
+                              (size_t)image);
+
+    // 所有的状态修改都在主线程中进行
+    auto self = shared_from_this();
+    brls::sync([self, image, data]() {
+        if (image && data && self->state == State::LOADING) {
+            self->queueUpload(data);
+            return;
+        }
+        if (image) brls::Logger::verbose("undone pic:{}", self->imageUrl);
+        self->finish();
+    });
+}
+
+void ImageHelper::queueUpload(std::shared_ptr<ImageData> data) {
+    this->bitmap = std::move(data);
+    uploads.push_back(shared_from_this());
+    if (uploadScheduled) return;
+    // 同一帧中完成的图片集中在下一帧开始上传
+    uploadScheduled = true;
+    brls::sync([]() { ImageHelper::drainUploads(); });
+}
+
+void ImageHelper::drainUploads() {
+    auto start   = std::chrono::steady_clock::now();
+    size_t count = 0;
+    while (!uploads.empty()) {
+        // 先上传距离可见区域最近的图片
+        auto next = std::min_element(
+            uploads.begin(), uploads.end(),
+            [](const std::shared_ptr<ImageHelper>& a,
+               const std::shared_ptr<ImageHelper>& b) {
+                return a->priority < b->priority;
+            });
+        auto item = *next;
+        uploads.erase(next);
+
+        // 等待上传时被取消的图片不再上传
+        if (item->state == State::LOADING) {
+            item->upload();
+            count++;
+        }
+        item->bitmap.reset();
+        item->finish();
+
+        auto cost = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        if (cost.count() >= UPLOAD_BUDGET) break;
+    }
+
+    uploadStats.frameUploads    = count;
+    uploadStats.maxFrameUploads = std::max(uploadStats.maxFrameUploads, count);
+    uploadStats.deferred        = uploads.size();
+    if (uploads.empty()) {
+        uploadScheduled = false;
+        return;
+    }
+    // 剩余的图片留到下一帧
+    uploadStats.totalDeferred += uploads.size();
+    brls::Logger::verbose("upload {} pics, {} deferred", count,
+                          uploads.size());
+    brls::sync([]() { ImageHelper::drainUploads(); });
+}
+
+void ImageHelper::upload() {
+    // 头像、角标等较小的图片放入图集，图集已满或图片较大时使用单独的纹理
+    auto& data       = *this->bitmap;
+    auto* atlasImage = dynamic_cast<AtlasImage*>(this->imageView);
+    if (atlasImage &&
+        TextureAtlas::instance().addCache(this->imageUrl, data.width,
+                                          data.height, data.pixels.data())) {
+        atlasImage->setAtlasImage(this->imageUrl);
+        return;
+    }
+    int tex = uploadImage(this->imageUrl, data);
+    if (tex <= 0) return;
+    this->imageView->innerSetImage(tex);
+    logFirstCover();
+}
+
+const ImageHelper::UploadStats& ImageHelper::getUploadStats() {
+    return uploadStats;
+}
+
+void ImageHelper::finish() {
+    if (this->imageView) {
+        auto it = requests.find(this->imageView);
+        if (it != requests.end() && it->second.get() == this)
+            requests.erase(it);
+        this->imageView->ptrUnlock();
+    } else {
+        prefetching.erase(this->imageUrl);
+    }
+    this->recycle();
+}
+
+void ImageHelper::recycle() {
+    this->state     = State::IDLE;
+    this->imageView = nullptr;
+    if (freeList.size() < FREE_LIST_SIZE)
+        freeList.push_back(shared_from_this());
+}
+
+std::string ImageHelper::download() {
+    cpr::Response r;
+    {
+        // 复用启动时预先建立的连接
+        auto session =
+            bilibili::SessionPool::instance().acquire(this->imageUrl);
+        session->SetUrl(cpr::Url{this->imageUrl});
+        // 连接池中的 Session 可能保留了其他请求设置的超时
+        session->SetTimeout(cpr::Timeout{0});
+        session->SetProgressCallback(cpr::ProgressCallback(
+            [this](cpr::cpr_off_t downloadTotal, cpr::cpr_off_t downloadNow,
+                   cpr::cpr_off_t uploadTotal, cpr::cpr_off_t uploadNow,
+                   intptr_t userdata) -> bool {
+                return this->state == State::LOADING;
+            }));
+        r = session->Get();
+    }
+    brls::Logger::verbose("net image status code: {} / {}", r.status_code,
+                          r.downloaded_bytes);
+    if (r.status_code != 200 || r.downloaded_bytes == 0) return "";
+    return std::move(r.text);
+}
+
+std::string ImageHelper::thumbnail(const std::string& url, float width,
+                                   ThumbnailType type) {
+    if (url.empty() || url.find('@') != std::string::npos) return url;
+
+    // 各类图片的标准尺寸，从小到大排列
+    static const std::vector<std::pair<int, int>> covers = {
+        {320, 180}, {480, 270}, {672, 378}, {960, 540}};
+    static const std::vector<std::pair<int, int>> verticals = {
+        {156, 210}, {234, 315}, {312, 420}, {468, 630}};
+    static const std::vector<std::pair<int, int>> avatars = {
+        {48, 48}, {72, 72}, {96, 96}, {160, 160}};
+
+    auto& sizes = type == ThumbnailType::VERTICAL ? verticals
+                  : type == ThumbnailType::AVATAR ? avatars
+                                                  : covers;
+    // 选择不小于显示尺寸的最小规格，未知宽度时使用默认规格
+    auto size = sizes[sizes.size() / 2];
+    if (width > 0) {
+        float pixel = width * brls::Application::windowScale;
+        size        = sizes.back();
+        for (auto& i : sizes) {
+            if (i.first >= pixel) {
+                size = i;
+                break;
+            }
+        }
+    }
+#ifdef USE_WEBP
+    const char* format = "webp";
+#else
+    const char* format = "jpg";
+#endif
+    return fmt::format("{}@{}w_{}h_1c.{}", url, size.first, size.second,
+                       format);
 }
 
 /// 清空图片内容
 void ImageHelper::clear(brls::Image* view) {
-    view->clear();
-    for (auto i : imagePool) {
-        if (i->getImageView() == view) {
-            // 图片正在加载中
-            brls::Logger::verbose("clear image2: {}", (size_t)view);
-            i->cancel();
-        }
+    auto* atlasImage = dynamic_cast<AtlasImage*>(view);
+    if (atlasImage) {
+        atlasImage->releaseImage();
+    } else {
+        TextureCache::instance().release(view->getTexture());
+        view->clear();
     }
+    auto it = requests.find(view);
+    if (it == requests.end()) return;
+    // 图片正在加载中
+    brls::Logger::verbose("clear image2: {}", (size_t)view);
+    it->second->cancel();
+    requests.erase(it);
 }
 
 brls::Image* ImageHelper::getImageView() { return this->imageView; }
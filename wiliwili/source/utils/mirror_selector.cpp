@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <borealis.hpp>
+#include <cpr/cpr.h>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#include "bilibili/util/http.hpp"
+#include "utils/mirror_selector.hpp"
+#include "utils/network_admission.hpp"
+
+/// 新的测速结果在历史得分中所占的比重
+static const double SCORE_WEIGHT = 0.5;
+
+/// 同时测速时的状态，每个链接在各自的线程中测速
+struct RankState {
+    std::mutex mutex;
+    size_t remaining;
+    MirrorSelector::Callback callback;
+};
+
+void MirrorSelector::rank(const std::vector<std::string>& urls,
+                          const Callback& callback) {
+    if (!ENABLED || urls.size() < 2) {
+        if (callback) callback(this->sort(urls));
+        return;
+    }
+    std::vector<std::string> sorted = this->sort(urls);
+    double best;
+    {
+        std::unique_lock<std::mutex> lock(mirrorMutex);
+        best = getScore(getHost(sorted[0]));
+    }
+    if (best < PROBE_TIMEOUT) {
+        // 已有较快的节点，直接使用
+        if (callback) callback(sorted);
+        this->refresh(urls);
+        return;
+    }
+
+    // 没有可用的历史得分时同时测速
+    // 出现足够快的节点或全部测速结束时回调，其余的测速结果只更新得分
+    auto state       = std::make_shared<RankState>();
+    state->remaining = urls.size();
+    state->callback  = callback;
+    for (auto& url : urls) {
+        cpr::async([this, url, urls, state]() {
+            double score = probe(url);
+            brls::Logger::debug("MirrorSelector: {} {:.0f}ms", getHost(url),
+                                score);
+            this->update(getHost(url), score);
+            Callback done;
+            bool last;
+            {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                last = --state->remaining == 0;
+                if (score <= FAST_SCORE || last) done.swap(state->callback);
+            }
+            if (done) done(this->sort(urls));
+            if (last) this->save();
+        });
+    }
+}
+
+void MirrorSelector::refresh(const std::vector<std::string>& urls) {
+    std::vector<std::string> stale;
+    {
+        std::unique_lock<std::mutex> lock(mirrorMutex);
+        int64_t now = std::time(nullptr);
+        for (auto& url : urls) {
+            std::string host = getHost(url);
+            auto it          = probeTimes.find(host);
+            if (it != probeTimes.end() && now - it->second < PROBE_INTERVAL)
+                continue;
+            if (!probing.insert(host).second) continue;
+            stale.push_back(url);
+        }
+    }
+    if (stale.empty()) return;
+
+    // 与封面下载一样受准入控制，播放器缓冲时等待，不与视频争抢带宽
+    NetworkAdmission::instance().submit([this, stale]() {
+        cpr::async([this, stale]() {
+            for (auto& url : stale) {
+                double score = probe(url);
+                brls::Logger::debug("MirrorSelector: {} {:.0f}ms",
+                                    getHost(url), score);
+                this->update(getHost(url), score);
+            }
+            {
+                std::unique_lock<std::mutex> lock(mirrorMutex);
+                for (auto& url : stale) probing.erase(getHost(url));
+            }
+            this->save();
+            NetworkAdmission::instance().release();
+        });
+    });
+}
+
+std::vector<std::string> MirrorSelector::sort(std::vector<std::string> urls) {
+    std::unique_lock<std::mutex> lock(mirrorMutex);
+    std::stable_sort(urls.begin(), urls.end(),
+                     [this](const std::string& a, const std::string& b) {
+                         return getScore(getHost(a)) < getScore(getHost(b));
+                     });
+    return urls;
+}
+
+void MirrorSelector::reportStall(const std::string& url) {
+    {
+        std::unique_lock<std::mutex> lock(mirrorMutex);
+        std::string host = getHost(url);
+        hostScores[host] = getScore(host) * 2 + PROBE_TIMEOUT;
+    }
+    this->save();
+}
+
+double MirrorSelector::probe(const std::string& url) {
+    // 连接失败或超时的节点
+    const double failed = PROBE_TIMEOUT * 2;
+
+    cpr::Session session;
+    cpr::Header header = bilibili::HTTP::HEADERS;
+    header["Range"]    = "bytes=0-" + std::to_string(PROBE_SIZE - 1);
+    session.SetUrl(cpr::Url{url});
+    session.SetHeader(header);
+    session.SetTimeout(cpr::Timeout{PROBE_TIMEOUT});
+#ifndef VERIFY_SSL
+    session.SetVerifySsl(cpr::VerifySsl{false});
+#endif
+    // 服务器不支持 Range 时下载够数据就中断
+    session.SetProgressCallback(cpr::ProgressCallback(
+        [](cpr::cpr_off_t downloadTotal, cpr::cpr_off_t downloadNow,
+           cpr::cpr_off_t uploadTotal, cpr::cpr_off_t uploadNow,
+           intptr_t userdata) -> bool {
+            return downloadNow < (cpr::cpr_off_t)PROBE_SIZE;
+        }));
+    cpr::Response r = session.Get();
+    if ((r.status_code != 200 && r.status_code != 206) || r.text.empty())
+        return failed;
+
+    double ttfb = 0;
+    curl_easy_getinfo(session.GetCurlHolder()->handle,
+                      CURLINFO_STARTTRANSFER_TIME, &ttfb);
+    double transfer = r.elapsed - ttfb;
+    if (transfer <= 0) return ttfb * 1000;
+    // 超时的请求按照已经下载的数据估算速度
+    double speed = r.text.size() / transfer;
+    return (ttfb + PROBE_SIZE / speed) * 1000;
+}
+
+void MirrorSelector::update(const std::string& host, double score) {
+    std::unique_lock<std::mutex> lock(mirrorMutex);
+    probeTimes[host] = std::time(nullptr);
+    auto it = hostScores.find(host);
+    if (it == hostScores.end()) {
+        hostScores[host] = score;
+    } else {
+        it->second = it->second * (1 - SCORE_WEIGHT) + score * SCORE_WEIGHT;
+    }
+}
+
+double MirrorSelector::getScore(const std::string& host) {
+    auto it = hostScores.find(host);
+    // 没有测速过的节点排在已知较快的节点之后
+    if (it == hostScores.end()) return PROBE_TIMEOUT;
+    return it->second;
+}
+
+std::string MirrorSelector::getHost(const std::string& url) {
+    size_t start = url.find("://");
+    start        = start == std::string::npos ? 0 : start + 3;
+    size_t end   = url.find('/', start);
+    if (end == std::string::npos) return url.substr(start);
+    return url.substr(start, end - start);
+}
+
+void MirrorSelector::load() {
+    if (HISTORY_PATH.empty()) return;
+    std::ifstream readFile(HISTORY_PATH);
+    if (!readFile) return;
+    try {
+        nlohmann::json content = nlohmann::json::parse(readFile);
+        std::unique_lock<std::mutex> lock(mirrorMutex);
+        hostScores.clear();
+        probeTimes.clear();
+        for (auto& item : content.items()) {
+            // 旧版本只保存了得分，视为已经过期
+            if (item.value().is_number()) {
+                hostScores[item.key()] = item.value().get<double>();
+                continue;
+            }
+            hostScores[item.key()] = item.value().at("score").get<double>();
+            probeTimes[item.key()] = item.value().at("time").get<int64_t>();
+        }
+    } catch (const std::exception& e) {
+        brls::Logger::error("MirrorSelector: cannot load {}: {}", HISTORY_PATH,
+                            e.what());
+    }
+}
+
+void MirrorSelector::save() {
+    if (HISTORY_PATH.empty()) return;
+    std::unique_lock<std::mutex> lock(mirrorMutex);
+    nlohmann::json content = nlohmann::json::object();
+    for (auto& i : hostScores) {
+        auto it          = probeTimes.find(i.first);
+        int64_t time     = it == probeTimes.end() ? 0 : it->second;
+        content[i.first] = {{"score", i.second}, {"time", time}};
+    }
+
+    // 先写入临时文件再重命名，避免程序退出时留下不完整的文件
+    std::error_code ec;
+    std::filesystem::create_directories(
+        std::filesystem::path(HISTORY_PATH).parent_path(), ec);
+    std::string temp = HISTORY_PATH + ".tmp";
+    std::ofstream writeFile(temp);
+    if (!writeFile) {
+        brls::Logger::error("MirrorSelector: cannot write to {}", temp);
+        return;
+    }
+    writeFile << content.dump();
+    writeFile.close();
+    std::filesystem::rename(temp, HISTORY_PATH, ec);
+}
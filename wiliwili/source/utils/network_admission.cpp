@@ -0,0 +1,160 @@
+#include "utils/network_admission.hpp"
+
+void NetworkAdmission::onMpvEvent(MpvEventEnum event, int64_t cacheSpeed) {
+    switch (event) {
+        case MpvEventEnum::LOADING_START:
+            setState(State::PAUSED);
+            break;
+        case MpvEventEnum::CACHE_SPEED_CHANGE:
+            if (getState() != State::PAUSED)
+                updateCacheSpeed(cacheSpeed);
+            else
+                checkPause();
+            break;
+        case MpvEventEnum::LOADING_END:
+        case MpvEventEnum::MPV_RESUME:
+            updateCacheSpeed(cacheSpeed);
+            break;
+        case MpvEventEnum::MPV_PAUSE:
+        case MpvEventEnum::MPV_STOP:
+        case MpvEventEnum::END_OF_FILE:
+            setState(State::OPEN);
+            break;
+        default:
+            break;
+    }
+}
+
+void NetworkAdmission::updateCacheSpeed(int64_t cacheSpeed) {
+    // 缓存已满时下载速度为 0，不需要限流
+    if (cacheSpeed > 0 && cacheSpeed < LOW_CACHE_SPEED)
+        setState(State::THROTTLED);
+    else
+        setState(State::OPEN);
+}
+
+void NetworkAdmission::checkPause() {
+    {
+        std::unique_lock<std::mutex> lock(admissionMutex);
+        if (state != State::PAUSED) return;
+        // 缓冲尚未结束，时间过长时不再完全暂停
+        auto pause = std::chrono::steady_clock::now() - pauseStart;
+        if (pause < std::chrono::milliseconds(MAX_PAUSE)) return;
+    }
+    setState(State::THROTTLED);
+}
+
+NetworkAdmission::State NetworkAdmission::getState() {
+    std::unique_lock<std::mutex> lock(admissionMutex);
+    return state;
+}
+
+bool NetworkAdmission::admissible() {
+    if (!ENABLED) return true;
+    switch (state) {
+        case State::OPEN:
+            return true;
+        case State::THROTTLED:
+            return running < THROTTLED_CONCURRENCY;
+        default:
+            return false;
+    }
+}
+
+std::vector<NetworkAdmission::Task> NetworkAdmission::admit() {
+    std::vector<Task> tasks;
+    while (!queued.empty() && admissible()) {
+        tasks.push_back(std::move(queued.front()));
+        queued.pop_front();
+        running++;
+    }
+    return tasks;
+}
+
+void NetworkAdmission::submit(const Task& task) {
+    checkPause();
+    {
+        std::unique_lock<std::mutex> lock(admissionMutex);
+        // 先来的请求优先
+        if (!queued.empty() || !admissible()) {
+            queued.push_back(task);
+            waitCount++;
+            return;
+        }
+        running++;
+    }
+    task();
+}
+
+void NetworkAdmission::release() {
+    std::vector<Task> tasks;
+    {
+        std::unique_lock<std::mutex> lock(admissionMutex);
+        if (running > 0) running--;
+        tasks = admit();
+    }
+    for (auto& task : tasks) task();
+}
+
+void NetworkAdmission::defer(const Task& task) {
+    checkPause();
+    {
+        std::unique_lock<std::mutex> lock(admissionMutex);
+        if (ENABLED && state == State::PAUSED) {
+            deferred.push_back(task);
+            deferCount++;
+            return;
+        }
+    }
+    task();
+}
+
+bilibili::CancelHandle NetworkAdmission::deferRequest(
+    const std::function<bilibili::CancelHandle()>& request) {
+    auto handle = bilibili::CancelToken::create();
+    this->defer([handle, request]() {
+        // 等待期间被取消的请求不再发起
+        if (!handle->isCancelled()) handle->delegate(request());
+    });
+    return handle;
+}
+
+void NetworkAdmission::setExecutor(const std::function<void(Task)>& value) {
+    std::unique_lock<std::mutex> lock(admissionMutex);
+    executor = value;
+}
+
+void NetworkAdmission::setTimer(const std::function<void(int, Task)>& value) {
+    std::unique_lock<std::mutex> lock(admissionMutex);
+    timer = value;
+}
+
+void NetworkAdmission::setState(State value) {
+    std::vector<Task> tasks, deferredTasks;
+    std::function<void(Task)> run;
+    std::function<void(int, Task)> delay;
+    {
+        std::unique_lock<std::mutex> lock(admissionMutex);
+        if (state == value) return;
+        state = value;
+        if (state == State::PAUSED) {
+            pauseStart = std::chrono::steady_clock::now();
+            delay      = timer;
+        } else {
+            tasks = admit();
+            deferredTasks.swap(deferred);
+            run = executor;
+        }
+    }
+    // 之前的暂停留下的定时检查会因为未到时间而忽略
+    if (delay) delay(MAX_PAUSE, [this]() { this->checkPause(); });
+    // 排队的下载只是提交到线程池，可以直接执行
+    for (auto& task : tasks) task();
+    // 延迟的请求在播放器的事件中恢复，交给 executor 执行，不阻塞主线程
+    for (auto& task : deferredTasks) {
+        if (run)
+            run(task);
+        else
+            task();
+    }
+}
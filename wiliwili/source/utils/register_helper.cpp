@@ -8,6 +8,7 @@
 #include "view/text_box.hpp"
 #include "view/qr_image.hpp"
 #include "view/svg_image.hpp"
+#include "view/atlas_image.hpp"
 #include "view/up_user_small.hpp"
 #include "view/recycling_grid.hpp"
 #include "view/grid_dropdown.hpp"
@@ -46,6 +47,7 @@ void Register::initCustomView() {
     brls::Application::registerXMLView("VideoView", VideoView::create);
     brls::Application::registerXMLView("QRImage", QRImage::create);
     brls::Application::registerXMLView("SVGImage", SVGImage::create);
+    brls::Application::registerXMLView("AtlasImage", AtlasImage::create);
     brls::Application::registerXMLView("TextBox", TextBox::create);
     brls::Application::registerXMLView("VideoProgressSlider",
                                        VideoProgressSlider::create);
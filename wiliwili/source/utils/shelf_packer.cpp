@@ -0,0 +1,45 @@
+#include <algorithm>
+#include <numeric>
+
+#include "utils/shelf_packer.hpp"
+
+bool ShelfPacker::allocate(int width, int height, int& x, int& y) {
+    if (width <= 0 || height <= 0 || width > size || height > size)
+        return false;
+    // 选择能放下矩形的最矮的一行，没有时在最下方新建一行
+    Shelf* best = nullptr;
+    for (auto& shelf : shelves) {
+        if (shelf.height < height || shelf.x + width > size) continue;
+        if (!best || shelf.height < best->height) best = &shelf;
+    }
+    if (!best) {
+        int top = 0;
+        if (!shelves.empty())
+            top = shelves.back().y + shelves.back().height + padding;
+        if (top + height > size) return false;
+        shelves.push_back({top, height, 0});
+        best = &shelves.back();
+    }
+    x = best->x;
+    y = best->y;
+    best->x += width + padding;
+    return true;
+}
+
+std::vector<ShelfPacker::Position> ShelfPacker::repack(
+    const std::vector<Position>& sizes) {
+    std::vector<size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) {
+        return sizes[a].second > sizes[b].second;
+    });
+
+    this->clear();
+    std::vector<Position> positions(sizes.size(), {-1, -1});
+    for (size_t i : order) {
+        int x, y;
+        if (this->allocate(sizes[i].first, sizes[i].second, x, y))
+            positions[i] = {x, y};
+    }
+    return positions;
+}
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <cstring>
+
+#include "utils/texture_atlas.hpp"
+
+bool TextureAtlas::getCache(const std::string& key) {
+    auto it = regions.find(key);
+    if (it == regions.end()) return false;
+    it->second.refs++;
+    return true;
+}
+
+bool TextureAtlas::getSize(const std::string& key, int& width,
+                           int& height) const {
+    auto it = regions.find(key);
+    if (it == regions.end()) return false;
+    width  = it->second.width;
+    height = it->second.height;
+    return true;
+}
+
+bool TextureAtlas::addCache(const std::string& key, int width, int height,
+                            const unsigned char* data) {
+    if (width <= 0 || height <= 0 || width > MAX_IMAGE_SIZE ||
+        height > MAX_IMAGE_SIZE)
+        return false;
+    if (this->getCache(key)) return true;
+
+    if (pixels.empty()) pixels.assign((size_t)ATLAS_SIZE * ATLAS_SIZE * 4, 0);
+    int x, y;
+    if (!packer.allocate(width, height, x, y)) {
+        this->defragment();
+        if (!packer.allocate(width, height, x, y)) return false;
+    }
+
+    for (int row = 0; row < height; row++)
+        memcpy(&pixels[((size_t)(y + row) * ATLAS_SIZE + x) * 4],
+               data + (size_t)row * width * 4, width * 4);
+    regions[key] = {x, y, width, height, 1};
+    stats.images++;
+    this->markDirty(x, y, width, height);
+    return true;
+}
+
+void TextureAtlas::release(const std::string& key) {
+    auto it = regions.find(key);
+    if (it == regions.end() || it->second.refs <= 0) return;
+    it->second.refs--;
+}
+
+bool TextureAtlas::getPaint(NVGcontext* vg, const std::string& key, float x,
+                            float y, float width, float height,
+                            NVGpaint& paint) {
+    auto it = regions.find(key);
+    if (it == regions.end()) return false;
+    auto& region = it->second;
+    if (region.texture > 0) {
+        paint = nvgImagePattern(vg, x, y, width, height, 0, region.texture,
+                                1.0f);
+        bound = false;
+        return true;
+    }
+    this->flush(vg);
+    if (texture <= 0) return false;
+
+    // 缩放整张图集，使图片所在的区域正好对齐绘制区域
+    float scaleX = width / region.width;
+    float scaleY = height / region.height;
+    paint        = nvgImagePattern(vg, x - region.x * scaleX,
+                                   y - region.y * scaleY, ATLAS_SIZE * scaleX,
+                                   ATLAS_SIZE * scaleY, 0, texture, 1.0f);
+    if (bound) stats.bindsSaved++;
+    stats.draws++;
+    bound = true;
+    return true;
+}
+
+void TextureAtlas::defragment() {
+    NVGcontext* vg = brls::Application::getNVGContext();
+    for (auto it = regions.begin(); it != regions.end();) {
+        if (it->second.refs <= 0) {
+            if (it->second.texture > 0) {
+                nvgDeleteImage(vg, it->second.texture);
+                stats.standalone--;
+            }
+            it = regions.erase(it);
+            stats.evictions++;
+        } else {
+            it++;
+        }
+    }
+
+    // 从高到低重新排列，同一行中的图片高度接近，浪费的空间更少
+    std::vector<std::pair<const std::string, Region>*> items;
+    std::vector<ShelfPacker::Position> sizes;
+    for (auto& i : regions) {
+        if (i.second.texture > 0) continue;
+        items.push_back(&i);
+        sizes.emplace_back(i.second.width, i.second.height);
+    }
+    auto positions = packer.repack(sizes);
+
+    std::vector<unsigned char> packed(pixels.size(), 0);
+    for (size_t i = 0; i < items.size(); i++) {
+        auto& region = items[i]->second;
+        int x = positions[i].first, y = positions[i].second;
+        if (x < 0) {
+            // 排列方式改变后放不下的图片复制到单独的纹理中
+            size_t stride = (size_t)region.width * 4;
+            std::vector<unsigned char> data(stride * region.height);
+            for (int row = 0; row < region.height; row++) {
+                size_t src =
+                    ((size_t)(region.y + row) * ATLAS_SIZE + region.x) * 4;
+                memcpy(&data[row * stride], &pixels[src], stride);
+            }
+            region.texture = nvgCreateImageRGBA(vg, region.width,
+                                                region.height, 0, data.data());
+            stats.standalone++;
+            brls::Logger::warning("TextureAtlas: {} moved out of the atlas",
+                                  items[i]->first);
+            continue;
+        }
+        for (int row = 0; row < region.height; row++) {
+            size_t src = ((size_t)(region.y + row) * ATLAS_SIZE + region.x) * 4;
+            size_t dst = ((size_t)(y + row) * ATLAS_SIZE + x) * 4;
+            memcpy(&packed[dst], &pixels[src], region.width * 4);
+        }
+        region.x = x;
+        region.y = y;
+    }
+    pixels.swap(packed);
+    stats.images = regions.size() - stats.standalone;
+    stats.defrags++;
+    this->markDirty(0, 0, ATLAS_SIZE, ATLAS_SIZE);
+    brls::Logger::debug("TextureAtlas: {} images after defragment",
+                        stats.images);
+}
+
+void TextureAtlas::markDirty(int x, int y, int width, int height) {
+    if (dirtyX1 <= dirtyX0) {
+        dirtyX0 = x;
+        dirtyY0 = y;
+        dirtyX1 = x + width;
+        dirtyY1 = y + height;
+        return;
+    }
+    dirtyX0 = std::min(dirtyX0, x);
+    dirtyY0 = std::min(dirtyY0, y);
+    dirtyX1 = std::max(dirtyX1, x + width);
+    dirtyY1 = std::max(dirtyY1, y + height);
+}
+
+void TextureAtlas::flush(NVGcontext* vg) {
+    if (dirtyX1 <= dirtyX0) return;
+    int x = dirtyX0, y = dirtyY0;
+    int width = dirtyX1 - dirtyX0, height = dirtyY1 - dirtyY0;
+    dirtyX0 = dirtyY0 = dirtyX1 = dirtyY1 = 0;
+
+    if (texture <= 0) {
+        texture = nvgCreateImageRGBA(vg, ATLAS_SIZE, ATLAS_SIZE, 0,
+                                     pixels.data());
+        stats.uploadBytes += pixels.size();
+        return;
+    }
+    // nvgUpdateImage 总是上传整张图集，这里只上传修改过的区域
+    // 数据按整张图集的行宽排列，由渲染后端跳过区域外的像素
+    NVGparams* params = nvgInternalParams(vg);
+    params->renderUpdateTexture(params->userPtr, texture, x, y, width, height,
+                                pixels.data());
+    stats.uploadBytes += (size_t)width * height * 4;
+}
@@ -0,0 +1,120 @@
+#include <algorithm>
+
+#include "view/atlas_image.hpp"
+#include "utils/cache_helper.hpp"
+#include "utils/texture_atlas.hpp"
+
+/// 与 brls::Image 相同，按照图片的宽高比计算未指定的宽高
+/// 使用图集时图片没有单独的纹理，需要从图集中读取原始尺寸
+static YGSize atlasImageMeasureFunc(YGNodeRef node, float width,
+                                    YGMeasureMode widthMode, float height,
+                                    YGMeasureMode heightMode) {
+    auto* view  = (brls::View*)YGNodeGetContext(node);
+    auto* image = static_cast<AtlasImage*>(view);
+    float imageWidth, imageHeight;
+    image->getImageSize(imageWidth, imageHeight);
+    YGSize size = {imageWidth, imageHeight};
+    if (imageWidth <= 0 || imageHeight <= 0) return size;
+
+    float ratio = imageWidth / imageHeight;
+    if (widthMode == YGMeasureModeExactly) {
+        size.width  = width;
+        size.height = width / ratio;
+        if (heightMode == YGMeasureModeExactly) size.height = height;
+        if (heightMode == YGMeasureModeAtMost)
+            size.height = std::min(size.height, height);
+    } else if (heightMode == YGMeasureModeExactly) {
+        size.height = height;
+        size.width  = height * ratio;
+        if (widthMode == YGMeasureModeAtMost)
+            size.width = std::min(size.width, width);
+    } else {
+        // 只有最大值限制时等比例缩小
+        float scale = 1;
+        if (widthMode == YGMeasureModeAtMost && imageWidth > width)
+            scale = width / imageWidth;
+        if (heightMode == YGMeasureModeAtMost && imageHeight * scale > height)
+            scale = height / imageHeight;
+        size.width  = imageWidth * scale;
+        size.height = imageHeight * scale;
+    }
+    return size;
+}
+
+AtlasImage::AtlasImage() {
+    YGNodeSetMeasureFunc(this->ygNode, atlasImageMeasureFunc);
+}
+
+AtlasImage::~AtlasImage() { this->releaseImage(); }
+
+void AtlasImage::setAtlasImage(const std::string& key) {
+    this->releaseImage();
+    this->atlasKey = key;
+    this->invalidate();
+}
+
+void AtlasImage::releaseImage() {
+    if (!this->atlasKey.empty()) {
+        TextureAtlas::instance().release(this->atlasKey);
+        this->atlasKey.clear();
+    }
+    if (this->getTexture() > 0) {
+        TextureCache::instance().release(this->getTexture());
+        this->clear();
+    }
+}
+
+void AtlasImage::getImageSize(float& width, float& height) {
+    int w = 0, h = 0;
+    if (!this->atlasKey.empty() &&
+        TextureAtlas::instance().getSize(this->atlasKey, w, h)) {
+        width  = w;
+        height = h;
+        return;
+    }
+    width  = this->getOriginalImageWidth();
+    height = this->getOriginalImageHeight();
+}
+
+void AtlasImage::draw(NVGcontext* vg, float x, float y, float width,
+                      float height, brls::Style style,
+                      brls::FrameContext* ctx) {
+    auto& atlas = TextureAtlas::instance();
+    if (this->atlasKey.empty()) {
+        if (this->getTexture() > 0) atlas.resetBinding();
+        Image::draw(vg, x, y, width, height, style, ctx);
+        return;
+    }
+
+    // 按照缩放方式计算图片的绘制区域，居中对齐
+    int imageWidth, imageHeight;
+    if (!atlas.getSize(this->atlasKey, imageWidth, imageHeight)) return;
+    float scaleX = width / imageWidth, scaleY = height / imageHeight;
+    switch (this->getScalingType()) {
+        case brls::ImageScalingType::STRETCH:
+            break;
+        case brls::ImageScalingType::FILL:
+            scaleX = scaleY = std::max(scaleX, scaleY);
+            break;
+        default:
+            scaleX = scaleY = std::min(scaleX, scaleY);
+            break;
+    }
+    float imageX = x + (width - imageWidth * scaleX) / 2;
+    float imageY = y + (height - imageHeight * scaleY) / 2;
+    NVGpaint paint;
+    if (!atlas.getPaint(vg, this->atlasKey, imageX, imageY,
+                        imageWidth * scaleX, imageHeight * scaleY, paint))
+        return;
+
+    // 填满时只绘制显示区域内的部分，不会采样到图集中相邻的图片
+    nvgBeginPath(vg);
+    nvgRoundedRect(vg, std::max(x, imageX), std::max(y, imageY),
+                   std::min(width, imageWidth * scaleX),
+                   std::min(height, imageHeight * scaleY),
+                   this->getCornerRadius());
+    nvgFillPaint(vg, a(paint));
+    nvgFill(vg);
+}
+
+brls::View* AtlasImage::create() { return new AtlasImage(); }
@@ -9,7 +9,15 @@ RecyclingGridItemHotsCard::RecyclingGridItemHotsCard() {
     this->inflateFromXMLRes("xml/views/hots_card.xml");
 }
 
-RecyclingGridItemHotsCard::~RecyclingGridItemHotsCard() {}
+RecyclingGridItemHotsCard::~RecyclingGridItemHotsCard() {
+    // 优先清空正在进行的图片请求
+    ImageHelper::clear(this->icon);
+}
+
+void RecyclingGridItemHotsCard::cacheForReuse() {
+    //准备回收该项
+    ImageHelper::clear(this->icon);
+}
 
 void RecyclingGridItemHotsCard::setCard(int order, std::string showName,
                                         std::string pic) {
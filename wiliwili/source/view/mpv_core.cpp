@@ -7,6 +7,7 @@
 #include "view/mpv_core.hpp"
 #include "pystring.h"
 #include "utils/config_helper.hpp"
+#include "utils/network_admission.hpp"
 
 #ifdef __SWITCH__
 #include <switch.h>
@@ -51,15 +52,27 @@ static void *get_proc_address(void *unused, const char *name) {
 }
 
 void MPVCore::on_update(void *self) {
-    brls::sync(
-        []() { mpv_render_context_update(MPVCore::instance().getContext()); });
+    brls::sync([]() {
+        auto &core = MPVCore::instance();
+        if (!core.mpv_context) return;
+        uint64_t flags = mpv_render_context_update(core.mpv_context);
+        // 只有 mpv 有新的画面时才需要重新渲染
+        if (flags & MPV_RENDER_UPDATE_FRAME) core.redraw = true;
+    });
 }
 
 void MPVCore::on_wakeup(void *self) {
     brls::sync([]() { MPVCore::instance().eventMainLoop(); });
 }
 
-MPVCore::MPVCore() { this->init(); }
+MPVCore::MPVCore() {
+    this->init();
+
+    // 播放器缓冲时限制后台网络请求
+    mpvCoreEvent.subscribe([this](MpvEventEnum event) {
+        NetworkAdmission::instance().onMpvEvent(event, this->cache_speed);
+    });
+}
 
 void MPVCore::init() {
     this->mpv = mpv_create();
@@ -81,6 +94,8 @@ void MPVCore::init() {
     mpv_set_option_string(mpv, "osd-level", "0");
     mpv_set_option_string(mpv, "video-timing-offset", "0");  // 60fps
     mpv_set_option_string(mpv, "keep-open", "yes");
+    // 提前打开播放列表中的下一个视频，减少切换分P时的等待
+    mpv_set_option_string(mpv, "prefetch-playlist", "yes");
     mpv_set_option_string(mpv, "hr-seek", "yes");
 
     if (MPVCore::LOW_QUALITY) {
@@ -135,6 +150,12 @@ void MPVCore::init() {
     //    check_error(mpv_observe_property(mpv, 7, "paused-for-cache", MPV_FORMAT_FLAG));
     //    check_error(mpv_observe_property(mpv, 8, "demuxer-cache-time", MPV_FORMAT_DOUBLE));
     //    check_error(mpv_observe_property(mpv, 9, "demuxer-cache-state", MPV_FORMAT_NODE));
+    check_error(mpv_observe_property(mpv, 10, "demuxer-cache-duration",
+                                     MPV_FORMAT_DOUBLE));
+    check_error(
+        mpv_observe_property(mpv, 11, "container-fps", MPV_FORMAT_DOUBLE));
+    check_error(
+        mpv_observe_property(mpv, 12, "demuxer-cache-idle", MPV_FORMAT_FLAG));
 
     // init renderer params
     mpv_opengl_init_params gl_init_params{get_proc_address, nullptr};
@@ -158,6 +179,7 @@ void MPVCore::init() {
     mpv_set_wakeup_callback(mpv, on_wakeup, this);
     // set render callback
     mpv_render_context_set_update_callback(mpv_context, on_update, this);
+    this->redraw = true;
 
     this->initializeGL();
 }
@@ -340,6 +362,8 @@ void MPVCore::setFrameSize(brls::Rect rect) {
                  GL_UNSIGNED_BYTE, nullptr);
     this->mpv_fbo.w = drawWidth;
     this->mpv_fbo.h = drawHeight;
+    // 重新申请的 texture 中没有画面
+    this->redraw = true;
 
     float new_min_x = rect.getMinX() / brls::Application::contentWidth * 2 - 1;
     float new_min_y = 1 - rect.getMinY() / brls::Application::contentHeight * 2;
@@ -364,32 +388,58 @@ bool MPVCore::isValid() { return mpv_context != nullptr; }
 void MPVCore::openglDraw(brls::Rect rect, float alpha) {
     if (mpv_context == nullptr) return;
 
-    mpv_render_context_render(this->mpv_context, mpv_params);
-
 #ifdef __SWITCH__
-    glViewport(0, 0, brls::Application::windowWidth,
-               brls::Application::windowHeight);  // restore viewport
+    int realWindowWidth  = brls::Application::windowWidth;
+    int realWindowHeight = brls::Application::windowHeight;
 #else
     // PC运行可能因为拖拽窗口导致画面比例不是默认的，所以需要重新计算一下宽高
     int realWindowWidth =
         (int)(brls::Application::windowScale * brls::Application::contentWidth);
     int realWindowHeight = (int)(brls::Application::windowScale *
                                  brls::Application::contentHeight);
-    glViewport(0, 0, realWindowWidth, realWindowHeight);
 #endif
 
-    // shader draw
-    glUseProgram(shader.prog);
-    glBindTexture(GL_TEXTURE_2D, this->media_texture);
-    glBindVertexArray(shader.vao);
+    // 全屏且不透明时直接渲染到窗口，不需要再将 texture 绘制到窗口上
+    // 窗口每一帧都会重新绘制，所以每一帧都需要渲染
+    // 暂停或低帧率的视频只在有新画面时渲染到 texture 的开销更低
+    bool direct = DIRECT_RENDER && !core_idle &&
+                  video_fps >= DIRECT_RENDER_FPS && alpha >= 1.0f &&
+                  rect.getMinX() <= 0 && rect.getMinY() <= 0 &&
+                  rect.getMaxX() >= brls::Application::contentWidth &&
+                  rect.getMaxY() >= brls::Application::contentHeight;
+    if (direct) {
+        mpv_opengl_fbo fbo{0, realWindowWidth, realWindowHeight};
+        mpv_render_param params[] = {{MPV_RENDER_PARAM_OPENGL_FBO, &fbo},
+                                     {MPV_RENDER_PARAM_FLIP_Y, &flip_y},
+                                     {MPV_RENDER_PARAM_INVALID, 0}};
+        this->render(params);
+        renderStats.direct++;
+        // texture 中的画面已经过期，退出全屏后需要重新渲染
+        this->redraw = true;
+    } else if (this->redraw) {
+        // 没有新的画面时直接绘制上一次渲染到 texture 中的画面
+        this->redraw = false;
+        this->render(mpv_params);
+    } else {
+        renderStats.skipped++;
+    }
 
-    // Set alpha
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    static GLuint alphaID = glGetUniformLocation(shader.prog, "Alpha");
-    glUniform1f(alphaID, alpha);
+    glViewport(0, 0, realWindowWidth, realWindowHeight);  // restore viewport
 
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+    if (!direct) {
+        // shader draw
+        glUseProgram(shader.prog);
+        glBindTexture(GL_TEXTURE_2D, this->media_texture);
+        glBindVertexArray(shader.vao);
+
+        // Set alpha
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        static GLuint alphaID = glGetUniformLocation(shader.prog, "Alpha");
+        glUniform1f(alphaID, alpha);
+
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+    }
 
     mpv_render_context_report_swap(this->mpv_context);
 
@@ -404,6 +454,16 @@ void MPVCore::openglDraw(brls::Rect rect, float alpha) {
     }
 }
 
+void MPVCore::render(mpv_render_param *params) {
+    auto start = std::chrono::steady_clock::now();
+    mpv_render_context_render(this->mpv_context, params);
+    renderStats.renderTime +=
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    renderStats.rendered++;
+}
+
 mpv_render_context *MPVCore::getContext() { return this->mpv_context; }
 
 mpv_handle *MPVCore::getHandle() { return this->mpv; }
@@ -496,7 +556,11 @@ void MPVCore::eventMainLoop() {
                         } else {
                             if (core_idle) {
                                 if (fabs(playback_time - duration) < 1 &&
-                                    duration > 0) {
+                                    duration > 0 && hasNext()) {
+                                    // 接着播放播放列表中预加载的视频
+                                    brls::Logger::info("========> NEXT FILE");
+                                } else if (fabs(playback_time - duration) < 1 &&
+                                           duration > 0) {
                                     brls::Logger::info("========> END OF FILE");
                                     this->pause();
                                     mpvCoreEvent.fire(
@@ -565,6 +629,30 @@ void MPVCore::eventMainLoop() {
                                      ->data;
                         }
                         break;
+                    case 10:
+                        // 已缓冲的时长
+                        if (((mpv_event_property *)event->data)->data) {
+                            cache_duration =
+                                *(double *)((mpv_event_property *)event->data)
+                                     ->data;
+                        }
+                        break;
+                    case 11:
+                        // 视频的帧率
+                        if (((mpv_event_property *)event->data)->data) {
+                            video_fps =
+                                *(double *)((mpv_event_property *)event->data)
+                                     ->data;
+                        }
+                        break;
+                    case 12:
+                        // 缓存是否已满
+                        if (((mpv_event_property *)event->data)->data) {
+                            cache_idle =
+                                *(int *)((mpv_event_property *)event->data)
+                                     ->data;
+                        }
+                        break;
                     default:
                         break;
                 }
@@ -598,6 +686,9 @@ void MPVCore::reset() {
     this->percent_pos    = 0;
     this->duration       = 0;  // second
     this->cache_speed    = 0;  // Bps
+    this->cache_duration = 0;  // second
+    this->video_fps      = 0;
+    this->cache_idle     = 0;
     this->playback_time  = 0;
     this->video_progress = 0;
 }
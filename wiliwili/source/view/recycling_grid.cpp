@@ -3,6 +3,7 @@
 //
 
 #include "view/recycling_grid.hpp"
+#include "utils/image_helper.hpp"
 #include <borealis/core/time.hpp>
 
 /// RecyclingGridItem
@@ -177,9 +178,7 @@ void RecyclingGrid::addCellAt(size_t index, int downSide) {
     RecyclingGridItem* cell;
     //获取到一个填充好数据的cell
     cell = dataSource->cellForRow(this, index);
-    cell->setWidth((renderedFrame.getWidth() - paddingLeft - paddingRight) /
-                       spanCount -
-                   estimatedRowSpace);
+    cell->setWidth(this->getItemWidth());
     cell->setDetachedPositionX(
         renderedFrame.getMinX() + paddingLeft +
         (renderedFrame.getWidth() - paddingLeft - paddingRight) / spanCount *
@@ -367,6 +366,12 @@ size_t RecyclingGrid::getRowCount() {
     return (this->dataSource->getItemCount() - 1) / this->spanCount + 1;
 }
 
+float RecyclingGrid::getItemWidth() {
+    return (renderedFrame.getWidth() - paddingLeft - paddingRight) /
+               spanCount -
+           estimatedRowSpace;
+}
+
 void RecyclingGrid::onNextPage(const std::function<void()>& callback) {
     this->nextPageCallback = callback;
 }
@@ -473,6 +478,9 @@ void RecyclingGrid::itemsRecyclingLoop() {
         addCellAt(visibleMax + 1, true);
     }
 
+    updateImagePriority(visibleFrame);
+    prefetchImages();
+
     if (visibleMax + 1 >= this->getItemCount()) {
         // 只有当 requestNextPage 为false时，才可以请求下一页，避免多次重复请求
         if (!requestNextPage && nextPageCallback) {
@@ -487,6 +495,55 @@ void RecyclingGrid::itemsRecyclingLoop() {
     }
 }
 
+void RecyclingGrid::updateImagePriority(const brls::Rect& visibleFrame) {
+    auto& children = contentBox->getChildren();
+    ImageHelper::updatePriority([&children, &visibleFrame](brls::View* view) {
+        // 不属于当前列表的图片，view 可能已经被删除，不能直接访问
+        if (std::find(children.begin(), children.end(), view) ==
+            children.end())
+            return -1.0f;
+        float top    = view->getDetachedPosition().y;
+        float bottom = top + view->getHeight();
+        return std::max({0.0f, visibleFrame.getMinY() - bottom,
+                         top - visibleFrame.getMaxY()});
+    });
+}
+
+void RecyclingGrid::prefetchImages() {
+    float offset      = this->getContentOffsetY();
+    brls::Time now    = brls::getCPUTimeUsec();
+    brls::Time last   = lastScrollTime;
+    float distance    = offset - lastContentOffset;
+    lastContentOffset = offset;
+    lastScrollTime    = now;
+    if (last == 0 || now <= last || distance == 0) return;
+
+    // 滑动速度 (dp/s)
+    float speed     = std::fabs(distance) * 1000000 / (now - last);
+    float rowHeight = estimatedRowHeight + estimatedRowSpace;
+    int rows        = std::min((int)(speed * prefetchTime / rowHeight) + 1,
+                               maxPrefetchLine);
+
+    size_t count = dataSource->getItemCount();
+    size_t start, end;
+    if (distance > 0) {
+        start = visibleMax + 1;
+        end   = std::min(count, start + rows * spanCount);
+    } else {
+        end   = std::min((size_t)visibleMin, count);
+        start = end > (size_t)rows * spanCount ? end - rows * spanCount : 0;
+    }
+    if (start >= end) return;
+
+    auto urls = dataSource->getImageUrls(this, start, end);
+    for (size_t i = 0; i < urls.size(); i++) {
+        // 离可见区域越远越晚下载
+        size_t index = distance > 0 ? i : urls.size() - 1 - i;
+        float row    = index / spanCount + 1;
+        ImageHelper::prefetch(urls[i], getItemWidth(), row * rowHeight);
+    }
+}
+
 RecyclingGridDataSource* RecyclingGrid::getDataSource() const {
     return this->dataSource;
 }
@@ -2,8 +2,89 @@
 // Created by fang on 2022/9/17.
 //
 
+#include <mutex>
+#include <unordered_map>
+
 #include "view/svg_image.hpp"
 #include "utils/cache_helper.hpp"
+#include "utils/config_helper.hpp"
+#include "utils/image_disk_cache.hpp"
+#include "utils/texture_atlas.hpp"
+
+/// 子线程中渲染好的 RGBA 图片
+struct SVGBitmap {
+    int width  = 0;
+    int height = 0;
+    std::string pixels;
+};
+
+/// 解析过的 SVG 文件，同一文件渲染为不同尺寸时不需要重新解析
+/// 图标文件的数量有限，不删除
+class SVGDocumentCache : public Singleton<SVGDocumentCache> {
+public:
+    std::shared_ptr<lunasvg::Document> get(const std::string& path) {
+        std::unique_lock<std::mutex> lock(documentMutex);
+        auto it = documents.find(path);
+        if (it != documents.end()) return it->second;
+        std::shared_ptr<lunasvg::Document> document =
+            lunasvg::Document::loadFromFile(path);
+        if (document) documents[path] = document;
+        return document;
+    }
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<lunasvg::Document>>
+        documents;
+    std::mutex documentMutex;
+};
+
+/// 渲染图标的线程，与图片下载的线程分开，渲染不会占用 cpr 的全局线程池
+/// 图标渲染只在布局或窗口大小改变时集中出现，少量线程即可
+class SVGThreadPool : public cpr::ThreadPool,
+                      public Singleton<SVGThreadPool> {
+public:
+    SVGThreadPool() : cpr::ThreadPool(1, 2, std::chrono::milliseconds(5000)) {
+        this->Start();
+    }
+
+    ~SVGThreadPool() { this->Stop(); }
+};
+
+/// 渲染 SVG 文件，优先读取磁盘缓存，在子线程中调用
+/// 磁盘缓存中保存 8 字节的宽高与 RGBA 数据，键中包含版本号，更新后重新渲染
+static std::shared_ptr<SVGBitmap> rasterize(const std::string& path,
+                                            const std::string& diskKey,
+                                            int width, int height) {
+    auto bitmap = std::make_shared<SVGBitmap>();
+    std::string data;
+    if (ImageDiskCache::instance().get(diskKey, data) && data.size() > 8) {
+        memcpy(&bitmap->width, &data[0], 4);
+        memcpy(&bitmap->height, &data[4], 4);
+        if ((size_t)bitmap->width * bitmap->height * 4 == data.size() - 8) {
+            bitmap->pixels = data.substr(8);
+            return bitmap;
+        }
+    }
+
+    auto document = SVGDocumentCache::instance().get(path);
+    if (!document) {
+        brls::Logger::error("SVGImage: cannot load {}", path);
+        return nullptr;
+    }
+    auto image = document->renderToBitmap(width, height);
+    if (!image.valid()) return nullptr;
+    image.convertToRGBA();
+    bitmap->width  = image.width();
+    bitmap->height = image.height();
+    bitmap->pixels.assign((const char*)image.data(),
+                          (size_t)bitmap->width * bitmap->height * 4);
+
+    data.assign(8, 0);
+    memcpy(&data[0], &bitmap->width, 4);
+    memcpy(&data[4], &bitmap->height, 4);
+    ImageDiskCache::instance().put(diskKey, data + bitmap->pixels);
+    return bitmap;
+}
 
 SVGImage::SVGImage() {
     this->registerFilePathXMLAttribute(
@@ -18,36 +99,89 @@ void SVGImage::setImageFromSVGRes(std::string name) {
 }
 
 void SVGImage::setImageFromSVGFile(const std::string value) {
-    int tex = TextureCache::instance().getCache(value);
-    if (tex > 0) {
-        brls::Logger::verbose("cache hit: {} {}", value, tex);
-        this->innerSetImage(tex);
+    this->svgFile   = value;
+    this->svgWidth  = this->getWidth() * brls::Application::windowScale;
+    this->svgHeight = this->getHeight() * brls::Application::windowScale;
+    // 布局完成前不知道显示尺寸，绘制时再加载
+    if (this->svgWidth <= 0 || this->svgHeight <= 0) {
+        this->svgKey.clear();
+        this->releaseImage();
         return;
     }
 
-    this->document = lunasvg::Document::loadFromFile(value.c_str());
-    this->updateBitmap();
+    // 同一图标的不同尺寸分别缓存
+    std::string key =
+        fmt::format("{}@{}x{}", value, this->svgWidth, this->svgHeight);
+    if (key == this->svgKey) return;
+    this->svgKey = key;
+    if (this->useCache(key)) return;
+
+    // 在子线程中渲染，渲染完成前继续显示之前的图片
+    std::string diskKey =
+        "svg:" + key + "#" + APPVersion::instance().getVersionStr();
+    int width = this->svgWidth, height = this->svgHeight;
+    this->ptrLock();
+    SVGThreadPool::instance().Submit([this, value, key, diskKey, width,
+                                      height]() {
+        auto bitmap = rasterize(value, diskKey, width, height);
+        brls::sync([this, key, bitmap]() {
+            if (bitmap)
+                this->applyBitmap(key, bitmap->width, bitmap->height,
+                                  (const unsigned char*)bitmap->pixels.data());
+            this->ptrUnlock();
+        });
+    });
+}
+
+void SVGImage::draw(NVGcontext* vg, float x, float y, float width,
+                    float height, brls::Style style, brls::FrameContext* ctx) {
+    // 窗口大小改变或首次布局后按照新的尺寸重新渲染
+    if (!this->svgFile.empty() &&
+        ((int)(width * brls::Application::windowScale) != this->svgWidth ||
+         (int)(height * brls::Application::windowScale) != this->svgHeight))
+        this->setImageFromSVGFile(this->svgFile);
+
+    AtlasImage::draw(vg, x, y, width, height, style, ctx);
+}
 
-    tex = this->getTexture();
+bool SVGImage::useCache(const std::string& key) {
+    if (TextureAtlas::instance().getCache(key)) {
+        this->setAtlasImage(key);
+        return true;
+    }
+    int tex = TextureCache::instance().getCache(key);
     if (tex > 0) {
-        brls::Logger::verbose("cache svg: {} {}", value, tex);
-        TextureCache::instance().addCache(value, tex);
+        brls::Logger::verbose("cache hit: {} {}", key, tex);
+        this->releaseImage();
+        this->innerSetImage(tex);
+        return true;
     }
+    return false;
 }
 
-void SVGImage::setImageFromSVGString(const std::string value) {
-    this->document = lunasvg::Document::loadFromData(value);
-    this->updateBitmap();
-}
+void SVGImage::applyBitmap(const std::string& key, int width, int height,
+                           const unsigned char* data) {
+    // 图片加入缓存时引用计数为 1，不再需要时直接释放
+    bool wanted = key == this->svgKey;
+    auto& atlas = TextureAtlas::instance();
+    if (atlas.addCache(key, width, height, data)) {
+        if (!wanted) {
+            atlas.release(key);
+            return;
+        }
+        this->setAtlasImage(key);
+        return;
+    }
 
-void SVGImage::updateBitmap() {
-    float width  = this->getWidth() * brls::Application::windowScale;
-    float height = this->getHeight() * brls::Application::windowScale;
-    auto bitmap  = this->document->renderToBitmap(width, height);
-    bitmap.convertToRGBA();
     NVGcontext* vg = brls::Application::getNVGContext();
-    int tex        = nvgCreateImageRGBA(vg, bitmap.width(), bitmap.height(), 0,
-                                        bitmap.data());
+    int tex        = nvgCreateImageRGBA(vg, width, height, 0, data);
+    tex            = TextureCache::instance().addCache(key, tex);
+    if (tex <= 0) return;
+    if (!wanted) {
+        TextureCache::instance().release(tex);
+        return;
+    }
+    this->releaseImage();
     this->innerSetImage(tex);
 }
 
@@ -223,6 +223,8 @@ RecyclingGridItemPGCVideoCard::RecyclingGridItemPGCVideoCard(
 RecyclingGridItemPGCVideoCard::~RecyclingGridItemPGCVideoCard() {
     // 优先清空正在进行的图片请求
     ImageHelper::clear(this->picture);
+    ImageHelper::clear(this->badgeTop);
+    ImageHelper::clear(this->badgeBottomLeft);
 }
 
 bool RecyclingGridItemPGCVideoCard::isVertical() {
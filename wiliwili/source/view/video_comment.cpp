@@ -4,6 +4,7 @@
 
 #include "view/video_comment.hpp"
 #include "utils/number_helper.hpp"
+#include "utils/image_helper.hpp"
 #include "bilibili.h"
 
 VideoComment::VideoComment() {
@@ -13,7 +14,7 @@ VideoComment::VideoComment() {
 
 VideoComment::~VideoComment() {
     brls::Logger::debug("View VideoComment: delete");
-    //    ImageHelper::clear(this->userInfo->getAvatar());
+    ImageHelper::clear(this->userInfo->getAvatar());
 }
 
 RecyclingGridItem* VideoComment::create() { return new VideoComment(); }
@@ -22,8 +23,10 @@ void VideoComment::setData(bilibili::VideoCommentResult data) {
     this->comment_data = data;
 
     this->label->setText(data.content.message);
-    this->userInfo->setUserInfo(data.member.avatar + "@96w_96h_1c.jpg",
-                                data.member.uname,
+    auto avatar = ImageHelper::thumbnail(
+        data.member.avatar, this->userInfo->getAvatar()->getWidth(),
+        ThumbnailType::AVATAR);
+    this->userInfo->setUserInfo(avatar, data.member.uname,
                                 wiliwili::sec2date(data.ctime));
 }
 
@@ -359,6 +359,29 @@ void VideoView::draw(NVGcontext* vg, float x, float y, float width,
     this->buttonProcessing();
 
     osdCenterBox->frame(ctx);
+
+    if (MPVCore::DEBUG_INFO) {
+        this->updateDebugInfo();
+        videoLayerDebug->frame(ctx);
+    }
+}
+
+void VideoView::updateDebugInfo() {
+    brls::Time now = getCPUTimeUsec();
+    if (now - debugUpdateTime < 1000000) return;
+    double seconds  = (now - debugUpdateTime) / 1e6;
+    debugUpdateTime = now;
+
+    // 显示最近一秒的渲染次数，以及每次渲染的平均耗时
+    auto& stats     = mpvCore->getRenderStats();
+    size_t rendered = stats.rendered - debugStats.rendered;
+    int64_t average = (stats.renderTime - debugStats.renderTime) /
+                      (int64_t)std::max<size_t>(rendered, 1);
+    videoDebugLabel->setText(fmt::format(
+        "render {:.0f}/s (direct {:.0f}/s, {}us)  skip {:.0f}/s",
+        rendered / seconds, (stats.direct - debugStats.direct) / seconds,
+        average, (stats.skipped - debugStats.skipped) / seconds));
+    debugStats = stats;
 }
 
 void VideoView::invalidate() { View::invalidate(); }
@@ -382,10 +405,7 @@ void VideoView::onLayout() {
     oldRect = rect;
 }
 
-void VideoView::setUrl(std::string url, int progress, std::string audio) {
-    brls::Logger::debug("set video url: {}", url);
-
-    if (progress < 0) progress = 0;
+std::string VideoView::getExtra(int progress, const std::string& audio) {
     std::string extra = "referrer=https://www.bilibili.com";
     if (progress > 0) {
         extra += fmt::format(",start={}", progress);
@@ -396,13 +416,10 @@ void VideoView::setUrl(std::string url, int progress, std::string audio) {
         brls::Logger::debug("set audio: {}", audio);
     }
     brls::Logger::debug("Extra options: {}", extra);
-
-    const char* cmd[] = {"loadfile", url.c_str(), "replace", extra.c_str(),
-                         NULL};
-    mpvCore->command_async(cmd);
+    return extra;
 }
 
-void VideoView::setUrl(const std::vector<EDLUrl>& edl_urls, int progress) {
+std::string VideoView::getEDLUrl(const std::vector<EDLUrl>& edl_urls) {
     std::string url = "edl://";
     std::vector<std::string> urls;
     bool delay_open = true;
@@ -422,7 +439,62 @@ void VideoView::setUrl(const std::vector<EDLUrl>& edl_urls, int progress) {
             fmt::format("%{}%{},length={}", i.url.size(), i.url, i.length));
     }
     url += pystring::join(";", urls);
-    this->setUrl(url, progress);
+    return url;
+}
+
+void VideoView::setUrl(std::string url, int progress, std::string audio) {
+    brls::Logger::debug("set video url: {}", url);
+
+    if (progress < 0) progress = 0;
+    std::string extra = getExtra(progress, audio);
+
+    // 清除预加载的下一个视频
+    const char* clear[] = {"playlist-clear", NULL};
+    mpvCore->command_async(clear);
+
+    const char* cmd[] = {"loadfile", url.c_str(), "replace", extra.c_str(),
+                         NULL};
+    mpvCore->command_async(cmd);
+    externalVideo = false;
+}
+
+void VideoView::setUrl(const std::vector<EDLUrl>& edl_urls, int progress) {
+    this->setUrl(getEDLUrl(edl_urls), progress);
+}
+
+void VideoView::appendUrl(std::string url, std::string audio) {
+    brls::Logger::debug("append video url: {}", url);
+
+    // 只保留一个预加载的视频
+    const char* clear[] = {"playlist-clear", NULL};
+    mpvCore->command_async(clear);
+
+    std::string extra = getExtra(0, audio);
+    const char* cmd[] = {"loadfile", url.c_str(), "append", extra.c_str(),
+                         NULL};
+    mpvCore->command_async(cmd);
+}
+
+void VideoView::appendUrl(const std::vector<EDLUrl>& edl_urls) {
+    this->appendUrl(getEDLUrl(edl_urls));
+}
+
+void VideoView::switchVideo(const std::string& url) {
+    brls::Logger::debug("switch video url: {}", url);
+
+    // 作为外部视频轨道加入并选中，mpv 从当前的进度开始加载
+    int64_t vid = 0;
+    mpvCore->get_property("vid", MPV_FORMAT_INT64, &vid);
+    const char* cmd[] = {"video-add", url.c_str(), "select", NULL};
+    mpvCore->command_async(cmd);
+
+    // 只能移除外部轨道，文件自带的视频轨道未选中时不会再下载
+    if (externalVideo && vid > 0) {
+        std::string id       = std::to_string(vid);
+        const char* remove[] = {"video-remove", id.c_str(), NULL};
+        mpvCore->command_async(remove);
+    }
+    externalVideo = true;
 }
 
 void VideoView::resume() { mpvCore->command_str("set pause no"); }
@@ -729,6 +801,7 @@ void VideoView::registerMpvEvent() {
                         "svg/bpx-svg-sprite-play.svg");
                     break;
                 case MpvEventEnum::START_FILE:
+                    this->externalVideo = false;
                     this->showOSD(false);
                     rightStatusLabel->setText("00:00");
                     leftStatusLabel->setText("00:00");